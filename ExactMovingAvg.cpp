@@ -0,0 +1,63 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+#include "ExactMovingAvg.h"
+
+#include <stdexcept>
+
+ExactMovingAvg::ExactMovingAvg(int maxSize) : maxSize(maxSize) {
+    slide = new circularDeque<fixedBar, true>(maxSize);
+}
+
+ExactMovingAvg::~ExactMovingAvg() {
+    delete slide;
+}
+
+void ExactMovingAvg::add(const fixedBar& bar) {
+    if (slide->size() == static_cast<std::size_t>(maxSize)) {
+        const fixedBar out = slide->getFront();
+        slide->popFront();
+        total.open   -= out.open;
+        total.close  -= out.close;
+        total.high   -= out.high;
+        total.low    -= out.low;
+        total.volume -= out.volume;
+    }
+    slide->insertBack(bar);
+    total.time    = bar.time;
+    total.open   += bar.open;
+    total.close  += bar.close;
+    total.high   += bar.high;
+    total.low    += bar.low;
+    total.volume += bar.volume;
+}
+
+int ExactMovingAvg::count() const {
+    return static_cast<int>(slide->size());
+}
+
+double ExactMovingAvg::average(std::int64_t sum) const {
+    if (slide->isEmpty()) throw std::runtime_error("No data");
+    return static_cast<double>(sum) / (static_cast<double>(slide->size()) * priceScale);
+}
+
+double ExactMovingAvg::openSMA() const {
+    return average(total.open);
+}
+
+double ExactMovingAvg::closeSMA() const {
+    return average(total.close);
+}
+
+double ExactMovingAvg::highSMA() const {
+    return average(total.high);
+}
+
+double ExactMovingAvg::lowSMA() const {
+    return average(total.low);
+}
+
+double ExactMovingAvg::volumeSMA() const {
+    if (slide->isEmpty()) throw std::runtime_error("No data");
+    return static_cast<double>(total.volume) / static_cast<double>(slide->size());
+}
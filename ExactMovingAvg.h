@@ -0,0 +1,68 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef EXACTMOVINGAVG_H
+#define EXACTMOVINGAVG_H
+#include <cstdint>
+#include "circularDeque.h"
+#include "fixedBar.h"
+
+/**
+ * @class ExactMovingAvg
+ *
+ * @brief Moving average over fixed-point bars, kept with integer running sums.
+ *
+ * MovingAvg adds and subtracts doubles on every update, so rounding error accumulates
+ * for as long as the process runs. ExactMovingAvg keeps its sums as integers: adding a
+ * bar and evicting the oldest are exact, the sums always equal a fresh recomputation over
+ * the window, and the only rounding happens once, in the final division of each SMA.
+ */
+class ExactMovingAvg {
+public:
+ /**
+  * @param maxSize The number of bars in the window.
+  */
+ explicit ExactMovingAvg(int maxSize);
+
+ ~ExactMovingAvg();
+
+ ExactMovingAvg(const ExactMovingAvg&) = delete;
+ ExactMovingAvg& operator=(const ExactMovingAvg&) = delete;
+
+ /**
+  * Adds a bar, evicting the oldest one once the window is full.
+  *
+  * @param bar The newest bar.
+  */
+ void add(const fixedBar& bar);
+
+ /**
+  * @return The number of bars currently in the window.
+  */
+ int count() const;
+
+ /**
+  * @return The exact sums of the bars in the window; `time` is the newest bar's timestamp.
+  */
+ const fixedBar& sums() const { return total; }
+
+ /**
+  * @return The SMA of each field, in price units (or shares for volume).
+  * @throws std::runtime_error if there is no data in the window.
+  */
+ double openSMA() const;
+ double closeSMA() const;
+ double highSMA() const;
+ double lowSMA() const;
+ double volumeSMA() const;
+
+private:
+ int maxSize;
+ fixedBar total;
+ circularDeque<fixedBar, true>* slide;
+
+ double average(std::int64_t sum) const;
+};
+
+#endif //EXACTMOVINGAVG_H
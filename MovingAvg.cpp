@@ -26,21 +26,20 @@ MovingAvg::MovingAvg(int maxSize)
 /**
  * @brief Adds a new data point to the sliding window and updates the aggregate values used for calculating moving averages.
  *
- * If the sliding window size exceeds the maximum size, the oldest data point is removed, and its values are subtracted
+ * Once the sliding window is full, the new data point overwrites the oldest one, whose values are subtracted
  * from the aggregate values.
  *
  * @param d The data point to add to the sliding window. It contains open, close, high, low, and volume values.
  */
 void MovingAvg::add(const data& d) {
-    if (slide->size == maxSize) {
-        const data& out = slide->getFront();
+    data out;
+    if (slide->pushEvict(d, out)) {
         open   -= out.open;
         close  -= out.close;
         high   -= out.high;
         volume -= out.volume;
         low    -= out.low;
     }
-    slide->insertBack(d);
     open   += d.open;
     close  += d.close;
     high   += d.high;
@@ -55,8 +54,8 @@ void MovingAvg::add(const data& d) {
  * @throws std::runtime_error if there is no data in the sliding window.
  */
 double MovingAvg::closeSMA() const {
-    if (slide->size == 0) throw std::runtime_error("No data");
-    return close / slide->size;
+    if (slide->isEmpty()) throw std::runtime_error("No data");
+    return close / static_cast<double>(slide->size());
 }
 
 /**
@@ -70,8 +69,8 @@ double MovingAvg::closeSMA() const {
  * @return The simple moving average (SMA) of the "open" values as a double.
  */
 double MovingAvg::openSMA() const {
-    if (slide->size == 0) throw std::runtime_error("No data");
-    return open / slide->size;
+    if (slide->isEmpty()) throw std::runtime_error("No data");
+    return open / static_cast<double>(slide->size());
 }
 
 /**
@@ -81,8 +80,8 @@ double MovingAvg::openSMA() const {
  * @throws std::runtime_error If there is no data in the moving average window.
  */
 double MovingAvg::volumeSMA() const {
-    if (slide->size == 0) throw std::runtime_error("No data");
-    return volume / slide->size;
+    if (slide->isEmpty()) throw std::runtime_error("No data");
+    return volume / static_cast<double>(slide->size());
 }
 
 /**
@@ -92,8 +91,8 @@ double MovingAvg::volumeSMA() const {
  * @throws std::runtime_error If there is no data available in the sliding window.
  */
 double MovingAvg::highSMA() const {
-    if (slide->size == 0) throw std::runtime_error("No data");
-    return high / slide->size;
+    if (slide->isEmpty()) throw std::runtime_error("No data");
+    return high / static_cast<double>(slide->size());
 }
 
 /**
@@ -106,8 +105,8 @@ double MovingAvg::highSMA() const {
  * @throws std::runtime_error if there is no data in the sliding window.
  */
 double MovingAvg::lowSMA() const {
-    if (slide->size == 0) throw std::runtime_error("No data");
-    return low / slide->size;
+    if (slide->isEmpty()) throw std::runtime_error("No data");
+    return low / static_cast<double>(slide->size());
 }
 
 
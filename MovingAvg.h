@@ -131,7 +131,7 @@ private:
   * Note that the exact usage and the unit of measurement for `volume`
   * should be clarified in the related code implementation or context.
   */
- int volume;
+ double volume;
  /**
   * @brief Represents an individual slide in a presentation or slideshow.
   *
@@ -0,0 +1,186 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "SpscRing.h"
+
+/**
+ * @brief Contention counters of an MpmcQueue.
+ */
+struct mpmcStats {
+    std::uint64_t pushContention = 0; // producers that lost a race for a slot and retried
+    std::uint64_t popContention = 0;  // consumers that lost a race for a slot and retried
+    std::uint64_t fullWaits = 0;      // blocking pushes that found the queue full
+    std::uint64_t emptyWaits = 0;     // blocking pops that found the queue empty
+};
+
+/**
+ * @class MpmcQueue
+ * @brief Bounded lock-free queue for any number of producer and consumer threads, e.g. many
+ * fetch workers feeding one computation stage.
+ *
+ * Dmitry Vyukov's design: every slot carries a sequence number that says whose turn it is.
+ * A producer claims position p with one CAS on the shared enqueue counter, but only after
+ * the slot's sequence reads p, meaning the previous lap's consumer is done with it; it then
+ * writes the element and publishes sequence p + 1. Consumers mirror this with p + 1 and hand
+ * the slot back with p + capacity. No thread ever waits on a lock, and producers and
+ * consumers only touch each other's data through the slot they are exchanging.
+ *
+ * The try_ calls fail immediately on a full or empty queue; push and pop spin briefly and
+ * then yield until they succeed.
+ *
+ * @tparam T The element type; must be default constructible and copy or move assignable,
+ *           as for circularDeque.
+ */
+template <typename T>
+class MpmcQueue {
+public:
+    /**
+     * @param capacity The minimum number of elements the queue can hold; rounded up to a power of two of at least 2.
+     * @throws std::invalid_argument if the capacity is 0.
+     */
+    explicit MpmcQueue(std::size_t capacity)
+        : slots(std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity)), mask(slots - 1),
+          cells(std::make_unique<cell[]>(slots)) {
+        if (capacity == 0) throw std::invalid_argument("Queue capacity must be positive");
+        for (std::size_t i = 0; i < slots; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * Appends an element unless the queue is full.
+     *
+     * @param value The element.
+     * @return false if the queue is full.
+     */
+    bool try_push(const T& value) { return emplace(value); }
+    bool try_push(T&& value) { return emplace(std::move(value)); }
+
+    /**
+     * Removes the oldest available element unless the queue is empty.
+     *
+     * @param out Receives the element.
+     * @return false if the queue is empty.
+     */
+    bool try_pop(T& out) {
+        std::uint64_t pos = dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell& c = cells[pos & mask];
+            const std::uint64_t seq = c.sequence.load(std::memory_order_acquire);
+            const std::int64_t dif = static_cast<std::int64_t>(seq - (pos + 1));
+            if (dif == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(c.value);
+                    c.sequence.store(pos + slots, std::memory_order_release);
+                    return true;
+                }
+                popContention.fetch_add(1, std::memory_order_relaxed);
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Appends an element, waiting for room if the queue is full.
+     */
+    void push(const T& value) {
+        if (try_push(value)) return;
+        fullWaits.fetch_add(1, std::memory_order_relaxed);
+        for (unsigned spins = 0; !try_push(value); ++spins) {
+            backoff(spins);
+        }
+    }
+
+    /**
+     * Removes the oldest element, waiting for one if the queue is empty.
+     */
+    void pop(T& out) {
+        if (try_pop(out)) return;
+        emptyWaits.fetch_add(1, std::memory_order_relaxed);
+        for (unsigned spins = 0; !try_pop(out); ++spins) {
+            backoff(spins);
+        }
+    }
+
+    /**
+     * @return The number of elements; only a snapshot while other threads are running.
+     */
+    std::size_t size() const {
+        const std::uint64_t tail = enqueuePos.load(std::memory_order_acquire);
+        const std::uint64_t head = dequeuePos.load(std::memory_order_acquire);
+        return tail > head ? static_cast<std::size_t>(tail - head) : 0;
+    }
+
+    std::size_t capacity() const { return slots; }
+
+    /**
+     * @return A snapshot of the contention counters.
+     */
+    mpmcStats stats() const {
+        return {pushContention.load(std::memory_order_relaxed), popContention.load(std::memory_order_relaxed),
+                fullWaits.load(std::memory_order_relaxed), emptyWaits.load(std::memory_order_relaxed)};
+    }
+
+private:
+    struct alignas(cacheLine) cell {
+        std::atomic<std::uint64_t> sequence;
+        T value;
+    };
+
+    const std::size_t slots;
+    const std::size_t mask;
+    const std::unique_ptr<cell[]> cells;
+
+    alignas(cacheLine) std::atomic<std::uint64_t> enqueuePos{0};
+    alignas(cacheLine) std::atomic<std::uint64_t> dequeuePos{0};
+    alignas(cacheLine) std::atomic<std::uint64_t> pushContention{0};
+    std::atomic<std::uint64_t> popContention{0};
+    std::atomic<std::uint64_t> fullWaits{0};
+    std::atomic<std::uint64_t> emptyWaits{0};
+
+    template <typename U>
+    bool emplace(U&& value) {
+        std::uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell& c = cells[pos & mask];
+            const std::uint64_t seq = c.sequence.load(std::memory_order_acquire);
+            const std::int64_t dif = static_cast<std::int64_t>(seq - pos);
+            if (dif == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = std::forward<U>(value);
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                pushContention.fetch_add(1, std::memory_order_relaxed);
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static void backoff(unsigned spins) {
+        if (spins >= 64) std::this_thread::yield();
+    }
+};
+
+#endif //MPMCQUEUE_H
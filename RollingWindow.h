@@ -0,0 +1,195 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef ROLLINGWINDOW_H
+#define ROLLINGWINDOW_H
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include "circularDeque.h"
+#include "data.h"
+
+/**
+ * Projections map a bar to the series being aggregated. A projection is invocable either
+ * with the bar alone or, for series such as returns, with the bar and the bar before it.
+ */
+struct closePrice {
+    double operator()(const data& d) const { return d.close; }
+};
+
+struct typicalPrice {
+    double operator()(const data& d) const { return (d.high + d.low + d.close) / 3; }
+};
+
+struct dollarVolume {
+    double operator()(const data& d) const { return d.close * d.volume; }
+};
+
+struct logReturn {
+    double operator()(const data& d, const data& previous) const { return std::log(d.close / previous.close); }
+};
+
+/**
+ * @brief Rolling sum; 0 over an empty window.
+ */
+struct rollingSum {
+    double sum = 0;
+    std::size_t count = 0;
+
+    void add(double x) { sum += x; count++; }
+    void remove(double x) { sum -= x; count--; }
+    double value() const { return sum; }
+};
+
+/**
+ * @brief Rolling mean.
+ */
+struct rollingMean {
+    double sum = 0;
+    std::size_t count = 0;
+
+    void add(double x) { sum += x; count++; }
+    void remove(double x) { sum -= x; count--; }
+    double value() const {
+        if (count == 0) throw std::runtime_error("No data");
+        return sum / count;
+    }
+};
+
+/**
+ * @brief Rolling population variance, updated with Welford's method in both directions.
+ */
+struct rollingVariance {
+    double mean = 0;
+    double m2 = 0;
+    std::size_t count = 0;
+
+    void add(double x) {
+        count++;
+        const double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    }
+    void remove(double x) {
+        if (--count == 0) {
+            mean = m2 = 0;
+            return;
+        }
+        const double delta = x - mean;
+        mean -= delta / count;
+        m2 -= delta * (x - mean);
+    }
+    double value() const {
+        if (count == 0) throw std::runtime_error("No data");
+        return m2 > 0 ? m2 / count : 0;
+    }
+};
+
+/**
+ * @brief One aggregate of one projected series, e.g. rolling<typicalPrice, rollingMean>.
+ *
+ * Holds only the aggregate's running state; the bars themselves live in the RollingWindow
+ * that owns it and are projected again when they leave the window.
+ */
+template <typename Projection, typename Kind>
+struct rolling {
+    [[no_unique_address]] Projection projection;
+    Kind kind;
+
+    static constexpr bool pairwise = std::invocable<const Projection&, const data&, const data&>;
+
+    void add(const data& bar, const data* previous) {
+        if constexpr (pairwise) {
+            if (previous) kind.add(projection(bar, *previous));
+        } else {
+            kind.add(projection(bar));
+        }
+    }
+    void remove(const data& bar, const data* previous) {
+        if constexpr (pairwise) {
+            if (previous) kind.remove(projection(bar, *previous));
+        } else {
+            kind.remove(projection(bar));
+        }
+    }
+
+    double value() const { return kind.value(); }
+};
+
+/**
+ * @class RollingWindow
+ * @brief A window of the last `length` bars shared by any number of rolling aggregates.
+ *
+ * Each bar is stored once, in a single ring, however many derived series are aggregated
+ * over it; adding a derived input is a new `rolling<Projection, Kind>` parameter instead of
+ * another copy of the window. Pairwise projections see the bar before each bar, so the ring
+ * keeps one bar more than the window, and the very first bar contributes no value to them.
+ *
+ * @tparam Aggregates rolling<Projection, Kind> instantiations.
+ */
+template <typename... Aggregates>
+class RollingWindow {
+public:
+    /**
+     * @param length The number of bars in the window.
+     */
+    explicit RollingWindow(int length) : length(length), slide(length + 1) {}
+
+    RollingWindow(const RollingWindow&) = delete;
+    RollingWindow& operator=(const RollingWindow&) = delete;
+
+    /**
+     * Adds a bar to every aggregate, evicting the bar that falls out of the window.
+     *
+     * @param bar The newest bar.
+     */
+    void add(const data& bar) {
+        if (slide.size() == static_cast<std::size_t>(length) + 1) {
+            // the ring holds the evicted bar's predecessor at the front
+            const data before = slide.getFront();
+            slide.popFront();
+            const data evicted = slide.getFront();
+            std::apply([&](auto&... aggregate) { (aggregate.remove(evicted, &before), ...); }, aggregates);
+        } else if (slide.size() == static_cast<std::size_t>(length)) {
+            const data evicted = slide.getFront();
+            std::apply([&](auto&... aggregate) { (aggregate.remove(evicted, nullptr), ...); }, aggregates);
+        }
+        const data* previous = nullptr;
+        data last;
+        if (!slide.isEmpty()) {
+            last = slide.getBack();
+            previous = &last;
+        }
+        std::apply([&](auto&... aggregate) { (aggregate.add(bar, previous), ...); }, aggregates);
+        slide.insertBack(bar);
+    }
+
+    /**
+     * @return The number of bars in the window.
+     */
+    int size() const { return std::min(static_cast<int>(slide.size()), length); }
+
+    /**
+     * @return The current value of the I-th aggregate.
+     * @throws std::runtime_error if that aggregate needs data it does not have yet.
+     */
+    template <std::size_t I>
+    double value() const { return std::get<I>(aggregates).value(); }
+
+    /**
+     * @return The I-th aggregate itself.
+     */
+    template <std::size_t I>
+    const auto& aggregate() const { return std::get<I>(aggregates); }
+
+private:
+    int length;
+    circularDeque<data, true> slide;
+    std::tuple<Aggregates...> aggregates;
+};
+
+#endif //ROLLINGWINDOW_H
@@ -0,0 +1,157 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * The cache line size assumed when separating data written by different threads.
+ */
+constexpr std::size_t cacheLine = 64;
+
+/**
+ * @class SpscRing
+ * @brief Lock-free ring that hands elements from exactly one producer thread to exactly one
+ * consumer thread, e.g. bars from the parser to the MovingAvg thread.
+ *
+ * Uses the same indexing as circularDeque<T, true>: a power-of-two array addressed by
+ * 64-bit head and tail counters through a mask. The producer owns the tail and the
+ * consumer the head; each publishes its counter with a release store and reads the other's
+ * with an acquire load. The two counters live on separate cache lines, and each side
+ * keeps a private copy of the other's last seen counter, so the shared line is only read
+ * again when the ring looks full (producer) or empty (consumer). The batch calls publish
+ * once per batch.
+ *
+ * @tparam T The element type; must be default constructible and copy or move assignable.
+ */
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @param capacity The minimum number of elements the ring can hold; rounded up to a power of two.
+     * @throws std::invalid_argument if the capacity is 0.
+     */
+    explicit SpscRing(std::size_t capacity)
+        : slots(std::bit_ceil(capacity)), mask(slots - 1), array(std::make_unique<T[]>(slots)) {
+        if (capacity == 0) throw std::invalid_argument("Ring capacity must be positive");
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * Producer only. Appends one element.
+     *
+     * @param value The element.
+     * @return false if the ring is full.
+     */
+    bool tryPush(const T& value) {
+        const std::uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == slots) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == slots) return false;
+        }
+        array[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Producer only. Appends as many of `count` elements as fit.
+     *
+     * @param values The elements.
+     * @param count The number of elements.
+     * @return The number appended, from the front of `values`.
+     */
+    std::size_t pushBatch(const T* values, std::size_t count) {
+        const std::uint64_t t = tail.load(std::memory_order_relaxed);
+        std::size_t room = slots - static_cast<std::size_t>(t - cachedHead);
+        if (room < count) {
+            cachedHead = head.load(std::memory_order_acquire);
+            room = slots - static_cast<std::size_t>(t - cachedHead);
+        }
+        const std::size_t n = count < room ? count : room;
+        for (std::size_t i = 0; i < n; ++i) {
+            array[(t + i) & mask] = values[i];
+        }
+        if (n) tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * Consumer only. Removes the oldest element.
+     *
+     * @param out Receives the element.
+     * @return false if the ring is empty.
+     */
+    bool tryPop(T& out) {
+        const std::uint64_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return false;
+        }
+        out = std::move(array[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Removes up to `max` of the oldest elements.
+     *
+     * @param out Room for `max` elements.
+     * @param max The most elements to remove.
+     * @return The number removed, oldest first.
+     */
+    std::size_t popBatch(T* out, std::size_t max) {
+        const std::uint64_t h = head.load(std::memory_order_relaxed);
+        std::size_t available = static_cast<std::size_t>(cachedTail - h);
+        if (available < max) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            available = static_cast<std::size_t>(cachedTail - h);
+        }
+        const std::size_t n = max < available ? max : available;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = std::move(array[(h + i) & mask]);
+        }
+        if (n) head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @return The number of elements; exact only when neither side is running.
+     */
+    std::size_t size() const {
+        return static_cast<std::size_t>(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+    }
+
+    bool isEmpty() const { return size() == 0; }
+
+    std::size_t capacity() const { return slots; }
+
+private:
+    // read-only after construction, shared by both sides
+    const std::size_t slots;
+    const std::size_t mask;
+    const std::unique_ptr<T[]> array;
+
+    // producer's line
+    alignas(cacheLine) std::atomic<std::uint64_t> tail{0};
+    std::uint64_t cachedHead = 0;
+
+    // consumer's line
+    alignas(cacheLine) std::atomic<std::uint64_t> head{0};
+    std::uint64_t cachedTail = 0;
+
+    // keeps whatever follows the ring off the consumer's line
+    alignas(cacheLine) char padding[1] = {};
+};
+
+#endif //SPSCRING_H
@@ -0,0 +1,122 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef STATICMOVINGAVG_H
+#define STATICMOVINGAVG_H
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "data.h"
+
+/**
+ * The bar fields a StaticMovingAvg can track, combined as a bit mask.
+ */
+enum smaField : unsigned {
+    smaOpen = 1,
+    smaClose = 2,
+    smaHigh = 4,
+    smaLow = 8,
+    smaVolume = 16,
+    smaAll = smaOpen | smaClose | smaHigh | smaLow | smaVolume,
+};
+
+/**
+ * @brief The window of one tracked field: a ring of the last values and their running sum.
+ */
+template <bool Tracked, std::size_t RingSize>
+struct smaColumn {
+    std::array<double, RingSize> ring{};
+    double sum = 0;
+
+    void push(std::size_t slot, std::size_t evictSlot, bool evict, double value) {
+        if (evict) sum -= ring[evictSlot];
+        ring[slot] = value;
+        sum += value;
+    }
+};
+
+/**
+ * @brief An untracked field; compiles to nothing.
+ */
+template <std::size_t RingSize>
+struct smaColumn<false, RingSize> {
+    void push(std::size_t, std::size_t, bool, double) {}
+};
+
+/**
+ * @class StaticMovingAvg
+ *
+ * @brief MovingAvg with the window length and the tracked fields fixed at compile time.
+ *
+ * The ring is rounded up to a power of two, so slot arithmetic is a mask instead of a
+ * modulo, and each full-window SMA is a multiply by the constexpr reciprocal of N rather
+ * than a divide (which may differ from the division in the last bit). Fields left out of
+ * `Fields` have no storage and no update code, and calling their getter does not compile.
+ * The whole window lives inline in the object, with no heap allocation.
+ *
+ * @tparam N The number of bars in the window.
+ * @tparam Fields The smaField bits to track.
+ */
+template <std::size_t N, unsigned Fields = smaAll>
+class StaticMovingAvg {
+    static_assert(N > 0, "the window must hold at least one bar");
+    static_assert((Fields & ~static_cast<unsigned>(smaAll)) == 0, "unknown smaField bits");
+
+public:
+    static constexpr std::size_t window = N;
+
+    /**
+     * Adds a bar, evicting the oldest one once the window is full.
+     *
+     * @param d The newest bar.
+     */
+    void add(const data& d) {
+        const std::size_t slot = pushed & mask;
+        const std::size_t evictSlot = (pushed - N) & mask;
+        const bool evict = pushed >= N;
+        open.push(slot, evictSlot, evict, d.open);
+        close.push(slot, evictSlot, evict, d.close);
+        high.push(slot, evictSlot, evict, d.high);
+        low.push(slot, evictSlot, evict, d.low);
+        volume.push(slot, evictSlot, evict, d.volume);
+        pushed++;
+    }
+
+    /**
+     * @return The number of bars currently in the window.
+     */
+    std::size_t size() const { return pushed < N ? static_cast<std::size_t>(pushed) : N; }
+
+    /**
+     * @return The SMA of the field over the window.
+     * @throws std::runtime_error if there is no data in the window.
+     */
+    double openSMA() const requires ((Fields & smaOpen) != 0) { return average(open.sum); }
+    double closeSMA() const requires ((Fields & smaClose) != 0) { return average(close.sum); }
+    double highSMA() const requires ((Fields & smaHigh) != 0) { return average(high.sum); }
+    double lowSMA() const requires ((Fields & smaLow) != 0) { return average(low.sum); }
+    double volumeSMA() const requires ((Fields & smaVolume) != 0) { return average(volume.sum); }
+
+private:
+    static constexpr std::size_t ringSize = std::bit_ceil(N);
+    static constexpr std::size_t mask = ringSize - 1;
+    static constexpr double reciprocal = 1.0 / static_cast<double>(N);
+
+    std::uint64_t pushed = 0;
+    [[no_unique_address]] smaColumn<(Fields & smaOpen) != 0, ringSize> open;
+    [[no_unique_address]] smaColumn<(Fields & smaClose) != 0, ringSize> close;
+    [[no_unique_address]] smaColumn<(Fields & smaHigh) != 0, ringSize> high;
+    [[no_unique_address]] smaColumn<(Fields & smaLow) != 0, ringSize> low;
+    [[no_unique_address]] smaColumn<(Fields & smaVolume) != 0, ringSize> volume;
+
+    double average(double sum) const {
+        if (pushed >= N) return sum * reciprocal;
+        if (pushed == 0) throw std::runtime_error("No data");
+        return sum / static_cast<double>(pushed);
+    }
+};
+
+#endif //STATICMOVINGAVG_H
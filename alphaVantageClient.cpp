@@ -0,0 +1,101 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "alphaVantageClient.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+AlphaVantageClient::AlphaVantageClient(std::size_t poolSize, std::string baseUrl, std::string apiKey)
+    : poolSize(std::max<std::size_t>(poolSize, 1)), baseUrl(std::move(baseUrl)), apiKey(std::move(apiKey)) {}
+
+cpr::Response AlphaVantageClient::fetch(const std::string& function, const std::string& symbol,
+                                        const std::string& interval) {
+    cpr::Response replayed;
+    if (replayResponse(symbol, replayed)) {
+        return replayed;
+    }
+    const std::string url = urlFor(function, symbol, interval);
+    std::unique_ptr<cpr::Session> session = acquire();
+    session->SetUrl(cpr::Url{url});
+
+    const auto start = std::chrono::steady_clock::now();
+    cpr::Response response = session->Get();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    release(std::move(session));
+    record(elapsed.count());
+    recordResponse(symbol, response);
+    return response;
+}
+
+fetchLatency AlphaVantageClient::latency() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}
+
+std::unique_ptr<cpr::Session> AlphaVantageClient::acquire() {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    sessionReturned.wait(lock, [this] { return !idle.empty() || created < poolSize; });
+    if (!idle.empty()) {
+        std::unique_ptr<cpr::Session> session = std::move(idle.back());
+        idle.pop_back();
+        return session;
+    }
+    // the slot is claimed before building outside the lock, and given back if that throws
+    created++;
+    lock.unlock();
+    try {
+        auto session = std::make_unique<cpr::Session>();
+        session->SetHeader(cpr::Header{{"Connection", "keep-alive"}});
+        return session;
+    } catch (...) {
+        lock.lock();
+        created--;
+        lock.unlock();
+        sessionReturned.notify_one();
+        throw;
+    }
+}
+
+void AlphaVantageClient::release(std::unique_ptr<cpr::Session> session) {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        idle.push_back(std::move(session));
+    }
+    sessionReturned.notify_one();
+}
+
+std::string AlphaVantageClient::urlFor(const std::string& function, const std::string& symbol,
+                                       const std::string& interval) {
+    std::string key = function;
+    key += '\n';
+    key += symbol;
+    key += '\n';
+    key += interval;
+    {
+        std::lock_guard<std::mutex> lock(urlMutex);
+        auto it = urls.find(key);
+        if (it != urls.end()) return it->second;
+    }
+
+    std::string url = baseUrl + "?" + queryParameters(function, symbol, interval, apiKey).GetContent(cpr::CurlHolder());
+    std::lock_guard<std::mutex> lock(urlMutex);
+    if (urls.size() >= maxCachedUrls) {
+        // any entry will do; a polling loop re-adds the symbols it still wants on its next pass
+        urls.erase(urls.begin());
+    }
+    urls.emplace(std::move(key), url);
+    return url;
+}
+
+void AlphaVantageClient::record(double ms) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.minMs = stats.count ? std::min(stats.minMs, ms) : ms;
+    stats.maxMs = std::max(stats.maxMs, ms);
+    stats.lastMs = ms;
+    stats.totalMs += ms;
+    stats.count++;
+}
@@ -0,0 +1,104 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef ALPHAVANTAGECLIENT_H
+#define ALPHAVANTAGECLIENT_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cpr/cpr.h>
+#include "apiaccess.h"
+
+/**
+ * @brief Wall clock latency of the fetches made through one client, in milliseconds.
+ */
+struct fetchLatency {
+    std::size_t count = 0;
+    double totalMs = 0;
+    double minMs = 0;
+    double maxMs = 0;
+    double lastMs = 0;
+
+    double meanMs() const { return count ? totalMs / count : 0; }
+};
+
+/**
+ * @class AlphaVantageClient
+ * @brief Alpha Vantage client that reuses HTTP connections across fetches.
+ *
+ * The free functions in apiaccess.cpp build a fresh cpr request per call and pay TCP and
+ * TLS setup every time. The client instead keeps a pool of cpr::Session objects; each
+ * session owns a curl handle whose connection stays alive between requests, so polls
+ * after the first skip the handshake. Query URLs are built once per (function, symbol,
+ * interval) through queryParameters and cpr's encoding, the same path as the free
+ * functions, and kept in a cache of at most maxCachedUrls entries.
+ *
+ * The client is safe to share between threads. At most `poolSize` requests are in flight
+ * at once; further callers block until a session is returned to the pool.
+ */
+class AlphaVantageClient {
+public:
+    /**
+     * @param poolSize The maximum number of sessions, i.e. of concurrent requests.
+     * @param baseUrl The query endpoint; point it at a local stand-in to run without the network.
+     * @param apiKey The API key appended to every request.
+     */
+    explicit AlphaVantageClient(std::size_t poolSize = 4, std::string baseUrl = ALPHA_VANTAGE_URL,
+                                std::string apiKey = API_KEY_1);
+
+    AlphaVantageClient(const AlphaVantageClient&) = delete;
+    AlphaVantageClient& operator=(const AlphaVantageClient&) = delete;
+
+    /**
+     * Fetches one query over a pooled session, or from the installed replayer if there is one.
+     *
+     * @param function The Alpha Vantage function, e.g. "TIME_SERIES_INTRADAY".
+     * @param symbol The ticker.
+     * @param interval The bar interval, e.g. "5min".
+     * @return The response; transport failures have `error` set.
+     */
+    cpr::Response fetch(const std::string& function, const std::string& symbol, const std::string& interval);
+
+    /**
+     * Fetches the 5min intraday series of a symbol.
+     *
+     * @param symbol The ticker.
+     * @return The response.
+     */
+    cpr::Response fetchIntraday(const std::string& symbol) { return fetch("TIME_SERIES_INTRADAY", symbol, "5min"); }
+
+    /**
+     * @return A snapshot of the fetch latency statistics.
+     */
+    fetchLatency latency() const;
+
+private:
+    std::size_t poolSize;
+    std::string baseUrl;
+    std::string apiKey;
+
+    std::mutex poolMutex;
+    std::condition_variable sessionReturned;
+    std::vector<std::unique_ptr<cpr::Session>> idle;
+    std::size_t created = 0;
+
+    static constexpr std::size_t maxCachedUrls = 256;
+    std::mutex urlMutex;
+    std::unordered_map<std::string, std::string> urls;
+
+    mutable std::mutex statsMutex;
+    fetchLatency stats;
+
+    std::unique_ptr<cpr::Session> acquire();
+    void release(std::unique_ptr<cpr::Session> session);
+    std::string urlFor(const std::string& function, const std::string& symbol, const std::string& interval);
+    void record(double ms);
+};
+
+#endif //ALPHAVANTAGECLIENT_H
@@ -4,100 +4,162 @@
 
 #include "apiaccess.h"
 
+#include <atomic>
+#include "barCache.h"
+#include "decimalParse.h"
+#include "mappedFile.h"
+#include "responseLog.h"
+
 using json = nlohmann::json;
 
 
 
 
+cpr::Parameters queryParameters(const std::string& function, const std::string& symbol,
+                                const std::string& interval, const std::string& apiKey) {
+    cpr::Parameters parameters{
+        {"function", function},
+        {"symbol", symbol},
+    };
+    if (!interval.empty()) {
+        parameters.Add({"interval", interval});
+    }
+    parameters.Add({"apikey", apiKey});
+    return parameters;
+}
+
+cpr::Parameters intradayParameters(const std::string& symbol) {
+    return queryParameters("TIME_SERIES_INTRADAY", symbol, "5min");
+}
+
+namespace {
+// read from every fetching thread, so swapped atomically
+std::atomic<ResponseRecorder*> activeRecorder = nullptr;
+std::atomic<ResponseReplayer*> activeReplayer = nullptr;
+}
+
+void setResponseRecorder(ResponseRecorder* recorder) {
+    activeRecorder.store(recorder);
+}
+
+void setResponseReplayer(ResponseReplayer* replayer) {
+    activeReplayer.store(replayer);
+}
+
+void recordResponse(const std::string& symbol, const cpr::Response& response, const std::string& month) {
+    if (ResponseRecorder* recorder = activeRecorder.load()) {
+        recorder->record(symbol, response.status_code, response.text, response.elapsed * 1000.0, month);
+    }
+}
+
+bool replayResponse(const std::string& symbol, cpr::Response& response, const std::string& month) {
+    ResponseReplayer* replayer = activeReplayer.load();
+    if (!replayer) return false;
+    response = cpr::Response();
+    if (std::optional<recordedResponse> recorded = replayer->fetch(symbol, month)) {
+        response.status_code = recorded->status;
+        response.text = std::move(recorded->body);
+        response.elapsed = recorded->latencyMs / 1000.0;
+    } else {
+        response.status_code = 404;
+    }
+    return true;
+}
+
+cpr::Response fetchIntraday(const std::string& symbol) {
+    cpr::Response res;
+    if (replayResponse(symbol, res)) {
+        return res;
+    }
+    res = cpr::Get(cpr::Url{ALPHA_VANTAGE_URL}, intradayParameters(symbol));
+    recordResponse(symbol, res);
+    return res;
+}
+
+cpr::Response fetchIntradayFull(const std::string& symbol, const std::string& baseUrl) {
+    cpr::Response res;
+    if (replayResponse(symbol, res)) {
+        return res;
+    }
+    cpr::Parameters parameters = intradayParameters(symbol);
+    parameters.Add({"outputsize", "full"});
+    res = cpr::Get(cpr::Url{baseUrl}, parameters);
+    recordResponse(symbol, res);
+    return res;
+}
+
+cpr::Response fetchIntradayMonth(const std::string& symbol, const std::string& month, const std::string& baseUrl) {
+    cpr::Response res;
+    if (replayResponse(symbol, res, month)) {
+        return res;
+    }
+    cpr::Parameters parameters = intradayParameters(symbol);
+    parameters.Add({"month", month});
+    parameters.Add({"outputsize", "full"});
+    res = cpr::Get(cpr::Url{baseUrl}, parameters);
+    recordResponse(symbol, res, month);
+    return res;
+}
+
+std::vector<data> cachedIntraday(BarCache& cache, const std::string& symbol, std::int64_t firstDay, std::int64_t lastDay,
+                                 const std::string& baseUrl) {
+    // the compact window is shorter than one extended-hours day, so it would never complete a day to cache
+    return cache.bars(symbol, firstDay, lastDay, feedNow(), [&baseUrl](const std::string& s) {
+        cpr::Response res = fetchIntradayFull(s, baseUrl);
+        if (res.error) {
+            throw std::runtime_error("Fetching " + s + " failed: " + res.error.message);
+        }
+        if (res.status_code != 200) {
+            throw std::runtime_error("Fetching " + s + " failed with HTTP status " + std::to_string(res.status_code));
+        }
+        return std::move(res.text);
+    });
+}
+
 json returnJson(const std::string& symbol) {
-    std::string url = "https://www.alphavantage.co/query?function=TIME_SERIES_INTRADAY&symbol="+ symbol + "&interval=5min&apikey=" + API_KEY_1;
-    cpr::Response res = cpr::Get(cpr::Url{url});
+    cpr::Response res = fetchIntraday(symbol);
     return res.text;
 }
 void printRawJson(const std::string& symbol) {
     //intraday time series daily
-    std::string url = "https://www.alphavantage.co/query?function=TIME_SERIES_INTRADAY&symbol="+ symbol + "&interval=5min&apikey=" + API_KEY_1;
-    cpr::Response res = cpr::Get(cpr::Url{url});
+    cpr::Response res = fetchIntraday(symbol);
 
     std::cout << "HTTP Status Code: " << res.status_code << "\n";
     std::cout << "Raw JSON response:\n" << res.text << "\n";
 }
 json retrieveRaw(const std::string& symbol ) {
-    std::string url = "https://www.alphavantage.co/query?function=TIME_SERIES_INTRADAY&symbol="+ target + "&interval=5min&apikey=" + API_KEY_1;
-    cpr::Response res = cpr::Get(cpr::Url{url});
+    cpr::Response res = fetchIntraday(symbol);
     return res.text;
 }
 
 
-data retrievePrice(const std::string& time, const json& feed) {
-    std::vector<double> stuffs;
+data retrievePrice(timestamp time, const json& feed) {
+    const auto bar = feed.find(formatTimestamp(time));
+    if (bar == feed.end()) {
+        throw std::runtime_error("Requested time not found in time series data.");
+    }
     try {
-        if (!feed.contains(time)) {
-            throw std::runtime_error("Requested time not found in time series data.");
-        }
-        json data = feed; // res.text
-        const json& timeData = feed[time];
-        //const json& timeSeries = data["Time Series (5min)"]; //"Time Series (5min)"
-
-        for (const std::string& sect : sections) {
-            const double price = std::stod(timeData[sect].get<std::string>()); //"Time Series (5min)"
-            //delete print statement later
-            std::cout << price << std::endl;
-            stuffs.push_back(price);
-        }
-        if (!feed.contains(time)) {
-            throw std::runtime_error("Requested time not found in time series data.");
-        }
-
+        return {time, parsePrice(bar->at(sections[0]).get<std::string>()), parsePrice(bar->at(sections[3]).get<std::string>()),
+                parsePrice(bar->at(sections[1]).get<std::string>()), parsePrice(bar->at(sections[2]).get<std::string>()),
+                parseVolume(bar->at(sections[4]).get<std::string>())};
     } catch (const std::exception& e) {
         std::cerr << "Error parsing JSON" << std::endl;
         throw std::runtime_error("Error parsing JSON");
     }
-    return {stuffs.at(0), stuffs.at(3), stuffs.at(1), stuffs.at(2), stuffs.at(4)};
 }
 
-std::string getTimeStamp() {
-    std::time_t currentTime = std::time(nullptr);
-    std::tm* localTime = std::localtime(&currentTime);
-    int roundedMinutes = 5 * std::round(localTime -> tm_min / 5.0);
-
-    // Handle overflow (59 → 60)
-    if (roundedMinutes >= 60) {
-        roundedMinutes = 0;
-        localTime->tm_hour += 1;
-    }
-    localTime->tm_min = roundedMinutes;
-    localTime->tm_sec = 0;
-    std::ostringstream timeStream;
-    timeStream <<  std::put_time(localTime, "%H:%M:00");
-    std::string timeStr = timeStream.str();
-    std::cout << timeStr << std::endl;
-
-
-    std::ostringstream dateStream;
-    dateStream << std::put_time(localTime, "%Y-%m-%d");
-    std::string dateStr = dateStream.str();
-    std::cout << dateStr << std::endl;
-
-    std::cout << dateStr << " " << timeStr << std::endl;
-    return dateStr + " " + timeStr;
+timestamp getTimeStamp() {
+    const timestamp now = feedNow();
+    return (now + 150) / 300 * 300;
 }
 
 
-json getAPIData() {  // this method is just for debugging because i can't afford to make a dozen api calls every time i test
-    std::ifstream file("/Users/25yoon/CLionProjects/APIEXP/sample.json");
-    if (!file.is_open()) {
-        std::cerr << "Failed to open sample.json\n";
-        return 0;
-    }
-
+json getAPIData(const std::string& path) {  // this method is just for debugging because i can't afford to make a dozen api calls every time i test
     try {
-        json data;
-        file >> data;  // Load and parse JSON
-        std::cout << data.dump(4) << std::endl;  // Pretty print with indentation
-        return data;
+        MappedFile file(path);
+        return json::parse(file.data(), file.data() + file.size());
     } catch (const std::exception& e) {
-        std::cerr << "JSON parsing error: " << e.what() << std::endl;
+        std::cerr << "Failed to load " << path << ": " << e.what() << std::endl;
     }
     return 0;
 
@@ -17,18 +17,148 @@
 #include <cmath>
 #include "data.h"
 #include <cstdlib>
-const std::string API_KEY_1 = std::getenv("API_KEY");
+const std::string API_KEY_1 = std::getenv("API_KEY") ? std::getenv("API_KEY") : "";
 const std::string target = "LMT"; // lockheed martin
 const std::string sections[5] = {"1. open", "2. high", "3. low", "4. close", "5. volume"};
+const std::string ALPHA_VANTAGE_URL = "https://www.alphavantage.co/query";
 using json = nlohmann::json;
 
+/**
+ * Builds the query parameters of an Alpha Vantage request.
+ *
+ * @param function The Alpha Vantage function, e.g. "TIME_SERIES_INTRADAY".
+ * @param symbol The ticker to request.
+ * @param interval The bar interval, e.g. "5min"; omitted when empty.
+ * @param apiKey The API key.
+ * @return The parameters; cpr URL-encodes them.
+ */
+cpr::Parameters queryParameters(const std::string& function, const std::string& symbol,
+                                const std::string& interval, const std::string& apiKey = API_KEY_1);
+
+/**
+ * Builds the query parameters of a 5min TIME_SERIES_INTRADAY request.
+ *
+ * @param symbol The ticker to request.
+ * @return The parameters, including the API key; cpr URL-encodes them.
+ */
+cpr::Parameters intradayParameters(const std::string& symbol);
+
+class ResponseRecorder;
+class ResponseReplayer;
+
+/**
+ * Installs a recorder that every fetch function appends its raw responses to. The pointer
+ * is swapped atomically, so it may be changed while other threads are fetching.
+ *
+ * @param recorder The recorder, or nullptr to stop recording. Must outlive every fetch
+ *                 started while it was installed.
+ */
+void setResponseRecorder(ResponseRecorder* recorder);
+
+/**
+ * Installs a replayer that every fetch path (fetchIntraday, fetchIntradayMonth, fetchAll and
+ * AlphaVantageClient) serves recorded responses from instead of going to the network.
+ * Symbols without a recorded response left get an empty 404 response. The pointer is
+ * swapped atomically, like the recorder's.
+ *
+ * @param replayer The replayer, or nullptr to go back to the network. Must outlive every
+ *                 fetch started while it was installed.
+ */
+void setResponseReplayer(ResponseReplayer* replayer);
+
+/**
+ * Serves a fetch from the installed replayer, if there is one. Every fetch entry point
+ * calls this before touching the network.
+ *
+ * @param symbol The ticker being fetched.
+ * @param response Receives the recorded response (or an empty 404) when a replayer is installed.
+ * @param month The month slice being fetched, "YYYY-MM"; empty for the latest window.
+ * @return true if a replayer is installed and `response` was filled from it.
+ */
+bool replayResponse(const std::string& symbol, cpr::Response& response, const std::string& month = "");
+
+/**
+ * Appends a response to the installed recorder, if any. fetchAll and AlphaVantageClient
+ * call this too, so every path to the API is captured.
+ *
+ * @param symbol The ticker that was fetched.
+ * @param response The response.
+ * @param month The month slice fetched, "YYYY-MM"; empty for the latest window.
+ */
+void recordResponse(const std::string& symbol, const cpr::Response& response, const std::string& month = "");
+
+/**
+ * Fetches the 5min intraday series of a symbol, through the installed replayer if there is
+ * one, and records the response.
+ *
+ * @param symbol The ticker to fetch.
+ * @return The response.
+ */
+cpr::Response fetchIntraday(const std::string& symbol);
+
+/**
+ * Fetches the trailing month of a symbol's 5min intraday series (outputsize=full), through
+ * the installed replayer if there is one, and records the response. Unlike the compact
+ * 100-bar window this spans whole trading days, so closed days can be cached from it.
+ *
+ * @param symbol The ticker to fetch.
+ * @param baseUrl The query endpoint; point it at a local stand-in to run without the network.
+ * @return The response.
+ */
+cpr::Response fetchIntradayFull(const std::string& symbol, const std::string& baseUrl = ALPHA_VANTAGE_URL);
+
+/**
+ * Fetches one month of a symbol's 5min intraday history (outputsize=full), through the
+ * installed replayer if there is one (matched on symbol and month), and records the
+ * response tagged with its month. Safe to call from several threads; wrap it with
+ * responseSliceFetch to hand it to BackfillLoader.
+ *
+ * @param symbol The ticker to fetch.
+ * @param month The month, "YYYY-MM".
+ * @param baseUrl The query endpoint; point it at a local stand-in to run without the network.
+ * @return The response.
+ */
+cpr::Response fetchIntradayMonth(const std::string& symbol, const std::string& month,
+                                 const std::string& baseUrl = ALPHA_VANTAGE_URL);
+
+class BarCache;
+
+/**
+ * Returns the 5min bars of days `firstDay` through `lastDay` (day numbers, see dayOf), with
+ * closed days read from `cache` and only a missing or still open day going to
+ * fetchIntradayFull. One fetch fills the cache with every closed day of the trailing month.
+ *
+ * @param cache The on-disk bar cache.
+ * @param symbol The ticker.
+ * @param firstDay The first day wanted.
+ * @param lastDay The last day wanted, inclusive.
+ * @param baseUrl The query endpoint; point it at a local stand-in to run without the network.
+ * @return The bars in ascending time order.
+ * @throws std::invalid_argument if the symbol cannot name a cache directory.
+ * @throws std::runtime_error if a needed fetch fails or the cache cannot be written.
+ */
+std::vector<data> cachedIntraday(BarCache& cache, const std::string& symbol, std::int64_t firstDay, std::int64_t lastDay,
+                                 const std::string& baseUrl = ALPHA_VANTAGE_URL);
+
 
 void printRawJson(const std::string& symbol);
-data retrievePrice(const std::string& time, const json& feed);
-std::string getTimeStamp();
+/**
+ * Looks up the bar keyed by `time` in a parsed "Time Series (5min)" object.
+ *
+ * @param time The bar's timestamp.
+ * @param feed The time series object.
+ * @return The bar, stamped with `time`.
+ * @throws std::runtime_error if the series has no such bar or a field is malformed.
+ */
+data retrievePrice(timestamp time, const json& feed);
+
+/**
+ * @return The current time on the feed's clock, rounded to the nearest 5min bar.
+ */
+timestamp getTimeStamp();
 json returnJson(const std::string& symbol);
 json retrieveRaw(const std::string& symbol);
-json getAPIData();
+json getAPIData(const std::string& path = "sample.json");
 
 
 
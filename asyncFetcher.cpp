@@ -0,0 +1,61 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "asyncFetcher.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+void fetchAll(const std::vector<std::string>& symbols, const fetchCallback& onResponse,
+              const std::string& baseUrl) {
+    std::vector<std::size_t> issued;
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        cpr::Response replayed;
+        if (replayResponse(symbols[i], replayed)) {
+            onResponse(symbols[i], replayed);
+        } else {
+            issued.push_back(i);
+        }
+    }
+
+    // each transfer pushes its response here as it completes; the caller sleeps until one lands
+    std::mutex mutex;
+    std::condition_variable completed;
+    std::deque<std::pair<std::size_t, cpr::Response>> done;
+
+    std::vector<cpr::AsyncWrapper<void>> pending;
+    pending.reserve(issued.size());
+    for (std::size_t i : issued) {
+        pending.push_back(cpr::GetCallback([&mutex, &completed, &done, i](cpr::Response response) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.emplace_back(i, std::move(response));
+            }
+            completed.notify_one();
+        }, cpr::Url{baseUrl}, intradayParameters(symbols[i])));
+    }
+
+    // the callbacks reference this frame, so every transfer is waited for even if a handler throws
+    auto drain = [&pending] {
+        for (cpr::AsyncWrapper<void>& transfer : pending) transfer.wait();
+    };
+    try {
+        for (std::size_t delivered = 0; delivered < pending.size(); ++delivered) {
+            std::unique_lock<std::mutex> lock(mutex);
+            completed.wait(lock, [&done] { return !done.empty(); });
+            auto [i, response] = std::move(done.front());
+            done.pop_front();
+            lock.unlock();
+
+            recordResponse(symbols[i], response);
+            onResponse(symbols[i], response);
+        }
+    } catch (...) {
+        drain();
+        throw;
+    }
+    drain();
+}
@@ -0,0 +1,36 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef ASYNCFETCHER_H
+#define ASYNCFETCHER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <cpr/cpr.h>
+#include "apiaccess.h"
+
+/**
+ * Receives one completed response. Runs on the thread that called fetchAll, one response at
+ * a time, so handlers need no locking of their own.
+ */
+using fetchCallback = std::function<void(const std::string& symbol, const cpr::Response& response)>;
+
+/**
+ * @brief Fetches the intraday series of many symbols concurrently.
+ *
+ * Every request is issued up front with cpr::GetCallback; each transfer pushes its response
+ * onto a completion queue, and the calling thread sleeps on that queue and hands responses
+ * to `onResponse` in the order they complete, so one slow symbol does not hold back the rest.
+ * Transport failures are delivered too, with `response.error` set and a status code of 0.
+ * With a replayer installed (see setResponseReplayer) responses come from the recording instead.
+ *
+ * @param symbols The tickers to fetch.
+ * @param onResponse Called once per symbol with its response.
+ * @param baseUrl The query endpoint; point it at a local stand-in to run without the network.
+ */
+void fetchAll(const std::vector<std::string>& symbols, const fetchCallback& onResponse,
+              const std::string& baseUrl = ALPHA_VANTAGE_URL);
+
+#endif //ASYNCFETCHER_H
@@ -0,0 +1,144 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "backfill.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include "barSeries.h"
+#include "ingest.h"
+
+namespace {
+
+/**
+ * Parses "YYYY-MM" into a month count since year 0.
+ */
+int parseMonth(const std::string& month) {
+    if (month.size() != 7 || month[4] != '-') {
+        throw std::runtime_error("Malformed month: " + month);
+    }
+    for (int i : {0, 1, 2, 3, 5, 6}) {
+        if (month[i] < '0' || month[i] > '9') throw std::runtime_error("Malformed month: " + month);
+    }
+    const int year = std::stoi(month.substr(0, 4));
+    const int m = std::stoi(month.substr(5, 2));
+    if (m < 1 || m > 12) throw std::runtime_error("Malformed month: " + month);
+    return year * 12 + m - 1;
+}
+
+/**
+ * Parses one month slice. A throttled or rejected call still arrives with HTTP 200, so a
+ * body without a time series is an error here rather than an empty month.
+ */
+std::vector<data> parseSlice(const std::string& body) {
+    std::vector<data> bars;
+    TimeSeriesScanner scanner(body);
+    if (!scanner.notice().empty()) {
+        throw std::runtime_error("Month slice was refused: " + std::string(scanner.notice()));
+    }
+    if (!scanner.hasSeries()) {
+        throw std::runtime_error("Month slice has no time series");
+    }
+    rawBar raw;
+    while (scanner.next(raw)) {
+        bars.push_back(parseBar(raw));
+    }
+    sortBars(bars.data(), bars.data() + bars.size());
+    return bars;
+}
+
+} // namespace
+
+std::vector<std::string> monthRange(const std::string& first, const std::string& last) {
+    std::vector<std::string> months;
+    char buffer[16];
+    for (int m = parseMonth(first), end = parseMonth(last); m <= end; ++m) {
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d", m / 12, m % 12 + 1);
+        months.emplace_back(buffer);
+    }
+    return months;
+}
+
+std::vector<data> mergeRuns(const std::vector<std::vector<data>>& runs) {
+    // (time, run) with the smallest time on top; among equal times the last run comes first
+    using head = std::pair<timestamp, std::size_t>;
+    auto later = [](const head& a, const head& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    };
+    std::priority_queue<head, std::vector<head>, decltype(later)> heads(later);
+    std::vector<std::size_t> cursor(runs.size(), 0);
+    std::size_t total = 0;
+    for (std::size_t r = 0; r < runs.size(); ++r) {
+        total += runs[r].size();
+        if (!runs[r].empty()) heads.emplace(runs[r][0].time, r);
+    }
+
+    std::vector<data> merged;
+    merged.reserve(total);
+    while (!heads.empty()) {
+        const auto [time, r] = heads.top();
+        heads.pop();
+        if (merged.empty() || merged.back().time != time) {
+            merged.push_back(runs[r][cursor[r]]);
+        }
+        if (++cursor[r] < runs[r].size()) heads.emplace(runs[r][cursor[r]].time, r);
+    }
+    return merged;
+}
+
+BackfillLoader::BackfillLoader(std::size_t threads)
+    : threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+std::vector<data> BackfillLoader::load(const std::string& symbol, const std::vector<std::string>& months,
+                                       const sliceFetch& fetch) {
+    return std::move(loadAll({symbol}, months, fetch)[symbol]);
+}
+
+std::unordered_map<std::string, std::vector<data>> BackfillLoader::loadAll(const std::vector<std::string>& symbols,
+                                                                           const std::vector<std::string>& months,
+                                                                           const sliceFetch& fetch) {
+    // slice i is symbol i / months.size(), month i % months.size()
+    const std::size_t sliceCount = symbols.size() * months.size();
+    std::vector<std::vector<data>> runs(sliceCount);
+    std::atomic<std::size_t> nextSlice{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto work = [&] {
+        for (std::size_t i; !failed && (i = nextSlice++) < sliceCount;) {
+            try {
+                runs[i] = parseSlice(fetch(symbols[i / months.size()], months[i % months.size()]));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < std::min(threads, sliceCount); ++t) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    if (error) std::rethrow_exception(error);
+
+    std::unordered_map<std::string, std::vector<data>> out;
+    for (std::size_t s = 0; s < symbols.size(); ++s) {
+        const auto first = runs.begin() + static_cast<std::ptrdiff_t>(s * months.size());
+        std::vector<std::vector<data>> symbolRuns(std::make_move_iterator(first),
+                                                  std::make_move_iterator(first + static_cast<std::ptrdiff_t>(months.size())));
+        out[symbols[s]] = mergeRuns(symbolRuns);
+    }
+    return out;
+}
@@ -0,0 +1,111 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef BACKFILL_H
+#define BACKFILL_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "data.h"
+
+/**
+ * Fetches the raw response body of one month of a symbol's intraday history.
+ * Called concurrently from the loader's worker threads.
+ */
+using sliceFetch = std::function<std::string(const std::string& symbol, const std::string& month)>;
+
+/**
+ * Adapts a fetch that returns an HTTP response, such as fetchIntradayMonth, to a sliceFetch.
+ * A slice is only handed on as a body if the transfer succeeded with status 200.
+ *
+ * @param fetch Called as fetch(symbol, month); returns a cpr::Response or anything with
+ *              the same `error`, `status_code` and `text` members.
+ * @return The slice fetch; it throws std::runtime_error for a failed or non-200 response.
+ */
+template <typename ResponseFetch>
+sliceFetch responseSliceFetch(ResponseFetch fetch) {
+    return [fetch = std::move(fetch)](const std::string& symbol, const std::string& month) {
+        auto response = fetch(symbol, month);
+        if (response.error) {
+            throw std::runtime_error("Fetching " + symbol + " " + month + " failed: " + response.error.message);
+        }
+        if (response.status_code != 200) {
+            throw std::runtime_error("Fetching " + symbol + " " + month + " failed with HTTP status " +
+                                     std::to_string(response.status_code));
+        }
+        return std::move(response.text);
+    };
+}
+
+/**
+ * Lists the months from `first` through `last`, both "YYYY-MM".
+ *
+ * @param first The first month.
+ * @param last The last month, inclusive.
+ * @return The months in ascending order; empty if `last` is before `first`.
+ * @throws std::runtime_error if either month is malformed.
+ */
+std::vector<std::string> monthRange(const std::string& first, const std::string& last);
+
+/**
+ * K-way merges sorted runs of bars into one ascending run. A timestamp present in several
+ * runs (overlapping slices) is kept once, from the run listed last.
+ *
+ * @param runs Runs of bars, each in ascending time order.
+ * @return The merged bars.
+ */
+std::vector<data> mergeRuns(const std::vector<std::vector<data>>& runs);
+
+/**
+ * @class BackfillLoader
+ * @brief Loads multi-month intraday history by fetching and parsing month slices in parallel.
+ *
+ * Every (symbol, month) slice is an independent task: worker threads take slices off a shared
+ * counter, fetch and parse each into a sorted run, and the runs of each symbol are then
+ * k-way merged. Throughput therefore scales with the thread count until the fetch function
+ * (or its rate limit) is the bottleneck.
+ */
+class BackfillLoader {
+public:
+    /**
+     * @param threads The number of worker threads; 0 uses one per hardware thread.
+     */
+    explicit BackfillLoader(std::size_t threads = 0);
+
+    /**
+     * Loads one symbol's history.
+     *
+     * @param symbol The ticker.
+     * @param months The months to load, "YYYY-MM".
+     * @param fetch Fetches one slice.
+     * @return The bars of all slices in ascending time order, without duplicates.
+     * @throws std::runtime_error (or whatever `fetch` throws) if any slice fails or its body
+     *         has no time series, e.g. a rate limit "Note" sent with HTTP 200.
+     */
+    std::vector<data> load(const std::string& symbol, const std::vector<std::string>& months, const sliceFetch& fetch);
+
+    /**
+     * Loads many symbols' history, spreading all of their slices over the same workers.
+     *
+     * @param symbols The tickers.
+     * @param months The months to load for each ticker, "YYYY-MM".
+     * @param fetch Fetches one slice.
+     * @return Each ticker's merged bars.
+     * @throws std::runtime_error (or whatever `fetch` throws) if any slice fails or its body
+     *         has no time series, e.g. a rate limit "Note" sent with HTTP 200.
+     */
+    std::unordered_map<std::string, std::vector<data>> loadAll(const std::vector<std::string>& symbols,
+                                                               const std::vector<std::string>& months,
+                                                               const sliceFetch& fetch);
+
+private:
+    std::size_t threads;
+};
+
+#endif //BACKFILL_H
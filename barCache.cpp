@@ -0,0 +1,124 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "barCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include "barStore.h"
+#include "ingest.h"
+
+namespace {
+
+const data* firstOnDay(const data* first, const data* last, std::int64_t day) {
+    return std::lower_bound(first, last, day * 86400,
+                            [](const data& d, timestamp t) { return d.time < t; });
+}
+
+/**
+ * A symbol becomes a path component and the 15 character symbol field of a .bars header,
+ * so it must not escape the cache root or be truncated on write.
+ */
+bool cacheableSymbol(const std::string& symbol) {
+    if (symbol.empty() || symbol.size() > sizeof(barStoreHeader::symbol) - 1 || !std::isalnum(static_cast<unsigned char>(symbol[0]))) {
+        return false;
+    }
+    return std::all_of(symbol.begin(), symbol.end(), [](unsigned char c) {
+        return std::isalnum(c) || c == '.' || c == '-';
+    });
+}
+
+} // namespace
+
+BarCache::BarCache(std::filesystem::path root, timestamp interval) : root(std::move(root)), interval(interval) {}
+
+std::filesystem::path BarCache::pathFor(const std::string& symbol, std::int64_t day) const {
+    if (!cacheableSymbol(symbol)) {
+        throw std::invalid_argument("Cannot cache bars for symbol \"" + symbol + "\"");
+    }
+    // "YYYY-MM-DD 00:00:00" -> "YYYY-MM-DD"
+    const std::string date = formatTimestamp(day * 86400).substr(0, 10);
+    return root / symbol / (std::to_string(interval / 60) + "min") / (date + ".bars");
+}
+
+bool BarCache::contains(const std::string& symbol, std::int64_t day) const {
+    std::error_code ec;
+    return std::filesystem::is_regular_file(pathFor(symbol, day), ec);
+}
+
+std::vector<data> BarCache::load(const std::string& symbol, std::int64_t day) const {
+    const BarStore store(pathFor(symbol, day).string());
+    if (store.symbol() != symbol || store.interval() != interval) {
+        throw std::runtime_error("Cached bars do not match " + pathFor(symbol, day).string());
+    }
+    std::vector<data> out;
+    out.reserve(store.size());
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        out.push_back(store.bar(i));
+    }
+    return out;
+}
+
+std::size_t BarCache::store(const std::string& symbol, const data* bars, std::size_t count, std::int64_t openDay) {
+    if (count == 0) return 0;
+    const data* last = bars + count;
+    const std::int64_t newest = std::min(dayOf(last[-1].time), openDay - 1);
+
+    std::size_t written = 0;
+    for (std::int64_t day = dayOf(bars[0].time) + 1; day <= newest; ++day) {
+        const std::filesystem::path path = pathFor(symbol, day);
+        if (contains(symbol, day)) continue;
+        std::filesystem::create_directories(path.parent_path());
+
+        const data* begin = firstOnDay(bars, last, day);
+        const data* end = firstOnDay(begin, last, day + 1);
+        // written under a temporary name so a reader never maps a half written day
+        std::filesystem::path partial = path;
+        partial += ".tmp";
+        writeBarStore(partial.string(), symbol, interval, begin, static_cast<std::size_t>(end - begin));
+        std::filesystem::rename(partial, path);
+        written++;
+    }
+    counters.daysWritten += written;
+    return written;
+}
+
+std::vector<data> BarCache::bars(const std::string& symbol, std::int64_t firstDay, std::int64_t lastDay,
+                                 timestamp now, const fetchFunction& fetch) {
+    const std::int64_t openDay = dayOf(now);
+    bool needFetch = false;
+    for (std::int64_t day = firstDay; day <= lastDay && !needFetch; ++day) {
+        needFetch = day >= openDay || !contains(symbol, day);
+    }
+
+    std::vector<data> fetched;
+    if (needFetch) {
+        counters.fetches++;
+        const std::string body = fetch(symbol);
+        TimeSeriesScanner scanner(body);
+        rawBar raw;
+        while (scanner.next(raw)) {
+            fetched.push_back(parseBar(raw));
+        }
+        sortBars(fetched.data(), fetched.data() + fetched.size());
+        store(symbol, fetched.data(), fetched.size(), openDay);
+    }
+
+    // days after the oldest fetched one are complete in the response; serve those from memory
+    const std::int64_t fetchedFrom = fetched.empty() ? lastDay + 1 : dayOf(fetched.front().time) + 1;
+    const data* fetchedEnd = fetched.data() + fetched.size();
+    std::vector<data> out;
+    for (std::int64_t day = firstDay; day <= lastDay; ++day) {
+        if (day < fetchedFrom && day < openDay && contains(symbol, day)) {
+            const std::vector<data> cached = load(symbol, day);
+            out.insert(out.end(), cached.begin(), cached.end());
+            counters.dayHits++;
+            continue;
+        }
+        const data* begin = firstOnDay(fetched.data(), fetchedEnd, day);
+        out.insert(out.end(), begin, firstOnDay(begin, fetchedEnd, day + 1));
+    }
+    return out;
+}
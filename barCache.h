@@ -0,0 +1,121 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef BARCACHE_H
+#define BARCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+#include "barSeries.h"
+#include "data.h"
+
+/**
+ * Returns the trading day a timestamp falls on, as a day count since 1970-01-01.
+ *
+ * @param t A timestamp on the feed's wall clock.
+ * @return The day number; days before 1970 are negative.
+ */
+inline std::int64_t dayOf(timestamp t) {
+    return t >= 0 ? t / 86400 : (t - 86399) / 86400;
+}
+
+/**
+ * @brief Counters of a BarCache.
+ */
+struct barCacheStats {
+    std::size_t dayHits = 0;   // days served from disk
+    std::size_t fetches = 0;   // calls to the fetch function
+    std::size_t daysWritten = 0;
+};
+
+/**
+ * @class BarCache
+ * @brief Disk cache of parsed bars, one .bars file per symbol, interval and trading day.
+ *
+ * Files live at root/SYMBOL/5min/YYYY-MM-DD.bars. Only closed days are ever written, so a
+ * cached day never changes and is served without a request; the still open day always goes
+ * to the network. A day with no bars (a weekend or holiday inside a fetched window) is stored
+ * as an empty file so it is not asked for again. The oldest day of a fetched window may be
+ * cut off by the response size and is therefore never cached from that response.
+ */
+class BarCache {
+public:
+    /**
+     * Fetches the raw response body of a symbol's intraday series.
+     */
+    using fetchFunction = std::function<std::string(const std::string& symbol)>;
+
+    /**
+     * @param root The cache directory; created on the first write.
+     * @param interval The spacing of the cached bars in seconds.
+     */
+    explicit BarCache(std::filesystem::path root, timestamp interval = barInterval);
+
+    /**
+     * @return The file that holds a symbol's bars for `day`.
+     * @throws std::invalid_argument if the symbol is not 1 to 15 letters, digits, '.' or '-'
+     *         starting with a letter or digit; it names a directory and the .bars header.
+     */
+    std::filesystem::path pathFor(const std::string& symbol, std::int64_t day) const;
+
+    /**
+     * @return Whether `day` is on disk for the symbol.
+     */
+    bool contains(const std::string& symbol, std::int64_t day) const;
+
+    /**
+     * Reads one cached day.
+     *
+     * @param symbol The ticker.
+     * @param day The day number.
+     * @return The day's bars in ascending time order.
+     * @throws std::runtime_error if the day is not cached or the file is corrupt.
+     */
+    std::vector<data> load(const std::string& symbol, std::int64_t day) const;
+
+    /**
+     * Writes every day of a fetched window that is complete and closed: the days after the
+     * oldest bar's day up to the newest bar's day, excluding `openDay` and later.
+     *
+     * @param symbol The ticker.
+     * @param bars The fetched bars in ascending time order.
+     * @param count The number of bars.
+     * @param openDay The day still trading; it and later days are never written.
+     * @return The number of days written.
+     * @throws std::runtime_error if a file cannot be written.
+     */
+    std::size_t store(const std::string& symbol, const data* bars, std::size_t count, std::int64_t openDay);
+
+    /**
+     * Returns the bars of days `firstDay` through `lastDay`, reading closed days from disk
+     * and calling `fetch` at most once if any requested day is open or not yet cached.
+     * Whatever the fetched window completes is written back before returning.
+     *
+     * @param symbol The ticker.
+     * @param firstDay The first day wanted.
+     * @param lastDay The last day wanted, inclusive.
+     * @param now The current time on the feed's wall clock; decides which day is open.
+     * @param fetch Fetches the raw response body for the symbol.
+     * @return The bars in ascending time order. Days the fetched window does not reach are missing.
+     * @throws std::runtime_error if the response is malformed or the cache cannot be written.
+     */
+    std::vector<data> bars(const std::string& symbol, std::int64_t firstDay, std::int64_t lastDay,
+                           timestamp now, const fetchFunction& fetch);
+
+    /**
+     * @return The hit, fetch and write counters since construction.
+     */
+    const barCacheStats& stats() const { return counters; }
+
+private:
+    std::filesystem::path root;
+    timestamp interval;
+    barCacheStats counters;
+};
+
+#endif //BARCACHE_H
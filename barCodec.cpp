@@ -0,0 +1,172 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "barCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+double fromFixed(std::int64_t fixed) {
+    return static_cast<double>(fixed) / 10000.0;
+}
+
+std::int64_t toFixed(double price) {
+    const std::int64_t fixed = std::llround(price * 10000.0);
+    if (fromFixed(fixed) != price) {
+        throw std::runtime_error("Bar price has more than four decimals");
+    }
+    return fixed;
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+} // namespace
+
+void BarEncoder::putUnsigned(std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<std::uint8_t>(value));
+}
+
+void BarEncoder::putSigned(std::int64_t value) {
+    putUnsigned(zigzag(value));
+}
+
+void BarEncoder::add(const data& bar) {
+    // check every field before any byte is emitted, so a rejected bar leaves the stream intact
+    const std::int64_t open = toFixed(bar.open);
+    const std::int64_t high = toFixed(bar.high);
+    const std::int64_t low = toFixed(bar.low);
+    const std::int64_t close = toFixed(bar.close);
+    const std::uint64_t volume = static_cast<std::uint64_t>(std::llround(bar.volume));
+    if (!(bar.volume >= 0) || static_cast<double>(volume) != bar.volume) {
+        throw std::runtime_error("Bar volume is not a whole count");
+    }
+
+    const std::int64_t delta = bar.time - prevTime;
+    putSigned(count < 2 ? delta : delta - prevDelta);
+    prevDelta = delta;
+    prevTime = bar.time;
+
+    putSigned(open - prevClose);
+    putSigned(high - open);
+    putSigned(low - open);
+    putSigned(close - open);
+    prevClose = close;
+
+    putUnsigned(volume);
+    count++;
+}
+
+BarDecoder::BarDecoder(std::span<const std::uint8_t> bytes, std::size_t count)
+    : pos(bytes.data()), end(bytes.data() + bytes.size()), remaining(count) {}
+
+std::uint64_t BarDecoder::getUnsigned() {
+    std::uint64_t value = 0;
+    int shift = 0;
+    while (true) {
+        if (pos == end) throw std::runtime_error("Compressed bar stream is truncated");
+        const std::uint8_t byte = *pos++;
+        // a 64 bit value takes at most ten bytes, and the tenth holds only the top bit
+        if (shift > 63 || (shift == 63 && (byte & 0x7E))) {
+            throw std::runtime_error("Compressed bar stream is corrupt");
+        }
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) return value;
+        shift += 7;
+    }
+}
+
+std::int64_t BarDecoder::getSigned() {
+    return unzigzag(getUnsigned());
+}
+
+bool BarDecoder::next(data& bar) {
+    if (remaining == 0) return false;
+
+    std::int64_t delta = getSigned();
+    if (decoded >= 2) delta += prevDelta;
+    prevDelta = delta;
+    prevTime += delta;
+    bar.time = prevTime;
+
+    const std::int64_t open = prevClose + getSigned();
+    const std::int64_t high = open + getSigned();
+    const std::int64_t low = open + getSigned();
+    const std::int64_t close = open + getSigned();
+    prevClose = close;
+    bar.open = fromFixed(open);
+    bar.high = fromFixed(high);
+    bar.low = fromFixed(low);
+    bar.close = fromFixed(close);
+    bar.volume = static_cast<double>(getUnsigned());
+
+    decoded++;
+    remaining--;
+    return true;
+}
+
+void writeCompressedBars(const std::string& path, std::string_view symbol, timestamp interval,
+                         const data* bars, std::size_t count) {
+    BarEncoder encoder;
+    for (std::size_t i = 0; i < count; ++i) {
+        encoder.add(bars[i]);
+    }
+
+    compressedBarHeader header{};
+    std::memcpy(header.magic, "BARZ", 4);
+    header.version = compressedBarVersion;
+    std::memcpy(header.symbol, symbol.data(), std::min(symbol.size(), sizeof(header.symbol) - 1));
+    header.interval = interval;
+    header.rows = count;
+    header.payloadBytes = encoder.bytes().size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to create " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(encoder.bytes().data()), static_cast<std::streamsize>(encoder.bytes().size()));
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+CompressedBarFile::CompressedBarFile(const std::string& path) : file(path), header(nullptr) {
+    if (file.size() < sizeof(compressedBarHeader)) {
+        throw std::runtime_error(path + " is not a .barz file");
+    }
+    header = reinterpret_cast<const compressedBarHeader*>(file.data());
+    if (std::memcmp(header->magic, "BARZ", 4) != 0) {
+        throw std::runtime_error(path + " is not a .barz file");
+    }
+    if (header->version != compressedBarVersion) {
+        throw std::runtime_error(path + " has unsupported .barz version " + std::to_string(header->version));
+    }
+    if (header->payloadBytes > file.size() - sizeof(compressedBarHeader)) {
+        throw std::runtime_error(path + " is truncated or corrupt");
+    }
+}
+
+std::string_view CompressedBarFile::symbol() const {
+    return {header->symbol, strnlen(header->symbol, sizeof(header->symbol))};
+}
+
+BarDecoder CompressedBarFile::decoder() const {
+    const auto* payload = reinterpret_cast<const std::uint8_t*>(file.data() + sizeof(compressedBarHeader));
+    return {std::span<const std::uint8_t>(payload, header->payloadBytes), size()};
+}
@@ -0,0 +1,174 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef BARCODEC_H
+#define BARCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "data.h"
+#include "mappedFile.h"
+
+/**
+ * Gorilla-style compression for archived bars.
+ *
+ * Each bar is encoded relative to the one before it, as a run of LEB128 varints:
+ *  - time: delta-of-delta against the previous two timestamps (0 for a regular 5min step),
+ *  - open: fixed-point delta against the previous close,
+ *  - high, low, close: fixed-point deltas against this bar's open,
+ *  - volume: the plain unsigned count.
+ * Signed values are zigzag encoded so small moves in either direction take one byte.
+ * Prices are held in ten-thousandths, the precision of the feed, so bars decoded from feed
+ * data are bit-identical to the originals; a price that does not survive that scaling, or a
+ * volume that is not a whole count, is rejected rather than silently rounded. Byte-aligned
+ * varints are used rather than Gorilla's bit-packed control codes because they decode
+ * without bit-level shifting.
+ */
+
+/**
+ * @class BarEncoder
+ * @brief Appends bars in ascending time order to a compressed byte stream.
+ */
+class BarEncoder {
+public:
+    /**
+     * Encodes one bar.
+     *
+     * @param bar The bar; must not be older than the previously added bar.
+     * @throws std::runtime_error if a price does not round-trip through ten-thousandths or the
+     *         volume is not a whole non-negative count; nothing is encoded in that case.
+     */
+    void add(const data& bar);
+
+    /**
+     * @return The number of bars encoded so far.
+     */
+    std::size_t size() const { return count; }
+
+    /**
+     * @return The encoded stream.
+     */
+    const std::vector<std::uint8_t>& bytes() const { return buffer; }
+
+private:
+    std::vector<std::uint8_t> buffer;
+    std::size_t count = 0;
+    timestamp prevTime = 0;
+    std::int64_t prevDelta = 0;
+    std::int64_t prevClose = 0;
+
+    void putUnsigned(std::uint64_t value);
+    void putSigned(std::int64_t value);
+};
+
+/**
+ * @class BarDecoder
+ * @brief Streams bars back out of a compressed byte stream, one at a time.
+ *
+ * The decoder keeps only the previous bar's state, so a whole archive can be fed into
+ * MovingAvg without ever materializing the decompressed array.
+ */
+class BarDecoder {
+public:
+    /**
+     * @param bytes The encoded stream; must outlive the decoder.
+     * @param count The number of bars in the stream.
+     */
+    BarDecoder(std::span<const std::uint8_t> bytes, std::size_t count);
+
+    /**
+     * Decodes the next bar.
+     *
+     * @param bar Receives the bar.
+     * @return false once every bar has been decoded.
+     * @throws std::runtime_error if the stream is truncated or corrupt.
+     */
+    bool next(data& bar);
+
+private:
+    const std::uint8_t* pos;
+    const std::uint8_t* end;
+    std::size_t remaining;
+    std::size_t decoded = 0;
+    timestamp prevTime = 0;
+    std::int64_t prevDelta = 0;
+    std::int64_t prevClose = 0;
+
+    std::uint64_t getUnsigned();
+    std::int64_t getSigned();
+};
+
+/**
+ * @brief On-disk header of a .barz file: this 64 byte header followed by the encoded stream.
+ */
+struct compressedBarHeader {
+    char magic[4];          // "BARZ"
+    std::uint32_t version;  // compressedBarVersion
+    char symbol[16];        // NUL padded
+    std::int64_t interval;  // seconds between bars
+    std::uint64_t rows;
+    std::uint64_t payloadBytes;
+    std::uint8_t reserved[16];
+};
+static_assert(sizeof(compressedBarHeader) == 64, "compressedBarHeader must stay 64 bytes");
+
+constexpr std::uint32_t compressedBarVersion = 1;
+
+/**
+ * Compresses bars into a .barz file.
+ *
+ * @param path The file to create or overwrite.
+ * @param symbol The ticker; at most 15 characters are kept.
+ * @param interval The spacing of the bars in seconds.
+ * @param bars The bars, in ascending time order.
+ * @param count The number of bars.
+ * @throws std::runtime_error if a bar cannot be encoded exactly or the file cannot be written.
+ */
+void writeCompressedBars(const std::string& path, std::string_view symbol, timestamp interval,
+                         const data* bars, std::size_t count);
+
+/**
+ * @class CompressedBarFile
+ * @brief Memory mapped reader for .barz files.
+ */
+class CompressedBarFile {
+public:
+    /**
+     * Maps and validates a .barz file.
+     *
+     * @param path The file to open.
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid .barz file.
+     */
+    explicit CompressedBarFile(const std::string& path);
+
+    /**
+     * @return The ticker the bars belong to.
+     */
+    std::string_view symbol() const;
+
+    /**
+     * @return The spacing of the bars in seconds.
+     */
+    timestamp interval() const { return header->interval; }
+
+    /**
+     * @return The number of bars in the file.
+     */
+    std::size_t size() const { return static_cast<std::size_t>(header->rows); }
+
+    /**
+     * @return A decoder positioned at the oldest bar of the file.
+     */
+    BarDecoder decoder() const;
+
+private:
+    MappedFile file;
+    const compressedBarHeader* header;
+};
+
+#endif //BARCODEC_H
@@ -0,0 +1,67 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "barColumns.h"
+
+#include <stdexcept>
+
+BarColumns::BarColumns(const data* bars, std::size_t count) {
+    reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        append(bars[i]);
+    }
+}
+
+BarColumns::BarColumns(const BarStore& store)
+    : timeColumn(store.times().begin(), store.times().end()),
+      openColumn(store.opens().begin(), store.opens().end()),
+      highColumn(store.highs().begin(), store.highs().end()),
+      lowColumn(store.lows().begin(), store.lows().end()),
+      closeColumn(store.closes().begin(), store.closes().end()),
+      volumeColumn(store.volumes().begin(), store.volumes().end()) {}
+
+void BarColumns::reserve(std::size_t n) {
+    timeColumn.reserve(n);
+    openColumn.reserve(n);
+    highColumn.reserve(n);
+    lowColumn.reserve(n);
+    closeColumn.reserve(n);
+    volumeColumn.reserve(n);
+}
+
+void BarColumns::clear() {
+    timeColumn.clear();
+    openColumn.clear();
+    highColumn.clear();
+    lowColumn.clear();
+    closeColumn.clear();
+    volumeColumn.clear();
+}
+
+void BarColumns::append(const data& bar) {
+    timeColumn.push_back(bar.time);
+    openColumn.push_back(bar.open);
+    highColumn.push_back(bar.high);
+    lowColumn.push_back(bar.low);
+    closeColumn.push_back(bar.close);
+    volumeColumn.push_back(bar.volume);
+}
+
+void BarColumns::toBars(data* out) const {
+    for (std::size_t i = 0; i < size(); ++i) {
+        out[i] = bar(i);
+    }
+}
+
+std::span<const double> BarColumns::column(barColumn c) const {
+    switch (c) {
+        case barColumn::open: return openColumn;
+        case barColumn::high: return highColumn;
+        case barColumn::low: return lowColumn;
+        case barColumn::close: return closeColumn;
+        case barColumn::volume: return volumeColumn;
+        case barColumn::time: break;
+    }
+    throw std::runtime_error("The time column is not a price column");
+}
@@ -0,0 +1,136 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef BARCOLUMNS_H
+#define BARCOLUMNS_H
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <vector>
+#include "barStore.h"
+#include "data.h"
+
+/**
+ * @brief Allocator that places every allocation on a 64-byte (cache line) boundary, so a
+ * column's first element is aligned for any vector width.
+ */
+template <typename T>
+struct alignedAllocator {
+    using value_type = T;
+    static constexpr std::align_val_t alignment{64};
+
+    alignedAllocator() = default;
+    template <typename U>
+    alignedAllocator(const alignedAllocator<U>&) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), alignment)); }
+    void deallocate(T* p, std::size_t) { ::operator delete(p, alignment); }
+
+    template <typename U>
+    bool operator==(const alignedAllocator<U>&) const { return true; }
+};
+
+template <typename T>
+using alignedVector = std::vector<T, alignedAllocator<T>>;
+
+/**
+ * @class BarColumns
+ * @brief Structure-of-arrays batch of bars: one aligned, contiguous array per field.
+ *
+ * `data` keeps a bar's fields together, so a kernel that only reads closes still pulls all
+ * six fields of every bar through the cache. BarColumns stores time, open, high, low, close
+ * and volume as separate arrays (the same column order as a .bars file), so such a kernel
+ * streams one column and the compiler is free to vectorize it. Bars are expected in
+ * ascending time order, as everywhere else in the engine.
+ */
+class BarColumns {
+public:
+    BarColumns() = default;
+
+    /**
+     * Copies a run of bars into columns.
+     *
+     * @param bars The bars.
+     * @param count The number of bars.
+     */
+    BarColumns(const data* bars, std::size_t count);
+
+    /**
+     * Copies the columns of a .bars file; the result outlives the mapping.
+     *
+     * @param store The open store.
+     */
+    explicit BarColumns(const BarStore& store);
+
+    /**
+     * @return The number of bars.
+     */
+    std::size_t size() const { return timeColumn.size(); }
+
+    bool empty() const { return timeColumn.empty(); }
+
+    /**
+     * Reserves room for `n` bars in every column.
+     */
+    void reserve(std::size_t n);
+
+    void clear();
+
+    /**
+     * Appends one bar, splitting it across the columns.
+     *
+     * @param bar The bar to append.
+     */
+    void append(const data& bar);
+
+    /**
+     * Reassembles one row into a `data` record.
+     *
+     * @param i The row, 0 through size() - 1.
+     * @return The bar at row `i`.
+     */
+    data bar(std::size_t i) const {
+        return {timeColumn[i], openColumn[i], closeColumn[i], highColumn[i], lowColumn[i], volumeColumn[i]};
+    }
+
+    /**
+     * Writes every row back out as `data` records.
+     *
+     * @param out Room for size() bars.
+     */
+    void toBars(data* out) const;
+
+    std::span<timestamp> times() { return timeColumn; }
+    std::span<double> opens() { return openColumn; }
+    std::span<double> highs() { return highColumn; }
+    std::span<double> lows() { return lowColumn; }
+    std::span<double> closes() { return closeColumn; }
+    std::span<double> volumes() { return volumeColumn; }
+
+    std::span<const timestamp> times() const { return timeColumn; }
+    std::span<const double> opens() const { return openColumn; }
+    std::span<const double> highs() const { return highColumn; }
+    std::span<const double> lows() const { return lowColumn; }
+    std::span<const double> closes() const { return closeColumn; }
+    std::span<const double> volumes() const { return volumeColumn; }
+
+    /**
+     * Looks up a price or volume column by name.
+     *
+     * @param c Any column except barColumn::time, which is not a double column; use times().
+     * @return The column.
+     */
+    std::span<const double> column(barColumn c) const;
+
+private:
+    alignedVector<timestamp> timeColumn;
+    alignedVector<double> openColumn;
+    alignedVector<double> highColumn;
+    alignedVector<double> lowColumn;
+    alignedVector<double> closeColumn;
+    alignedVector<double> volumeColumn;
+};
+
+#endif //BARCOLUMNS_H
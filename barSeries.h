@@ -0,0 +1,83 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef BARSERIES_H
+#define BARSERIES_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include "data.h"
+
+/**
+ * The spacing of consecutive bars in seconds; the whole engine is built around the 5min series.
+ */
+constexpr timestamp barInterval = 5 * 60;
+
+/**
+ * Converts an Alpha Vantage interval name ("1min", "5min", ... "60min") to seconds.
+ *
+ * @param name The value of the "4. Interval" meta data field.
+ * @return The interval in seconds, or 0 if the name is not a minute interval.
+ */
+inline timestamp parseInterval(std::string_view name) {
+    if (!name.ends_with("min")) return 0;
+    timestamp minutes = 0;
+    for (char c : name.substr(0, name.size() - 3)) {
+        if (c < '0' || c > '9') return 0;
+        minutes = minutes * 10 + (c - '0');
+    }
+    return minutes * 60;
+}
+
+/**
+ * Puts a run of bars into ascending time order.
+ *
+ * Alpha Vantage sends its series newest first, so the common case is a plain reversal;
+ * anything else is sorted by timestamp.
+ *
+ * @param first The first bar.
+ * @param last One past the last bar.
+ */
+inline void sortBars(data* first, data* last) {
+    auto byTime = [](const data& a, const data& b) { return a.time < b.time; };
+    auto newestFirst = [](const data& a, const data& b) { return a.time > b.time; };
+    if (std::is_sorted(first, last, newestFirst)) {
+        std::reverse(first, last);
+    } else if (!std::is_sorted(first, last, byTime)) {
+        std::sort(first, last, byTime);
+    }
+}
+
+/**
+ * Looks up the bar stamped `time` in a run of bars sorted by sortBars.
+ *
+ * @param first The first bar.
+ * @param last One past the last bar.
+ * @param time The timestamp to look up.
+ * @return A pointer to the bar, or nullptr if there is no bar at that time.
+ */
+inline const data* findBar(const data* first, const data* last, timestamp time) {
+    const data* it = std::lower_bound(first, last, time,
+                                      [](const data& d, timestamp t) { return d.time < t; });
+    return it != last && it->time == time ? it : nullptr;
+}
+
+/**
+ * Counts the bars missing between two consecutive bars of a series.
+ *
+ * Gaps are normal across sessions (overnight, weekends) and in thin extended hours trading,
+ * where Alpha Vantage skips intervals without trades.
+ *
+ * @param prev The earlier bar.
+ * @param next The later bar.
+ * @param interval The expected spacing of bars in seconds.
+ * @return The number of intervals without a bar, 0 when the bars are adjacent.
+ */
+inline std::int64_t missingBars(const data& prev, const data& next, timestamp interval = barInterval) {
+    const std::int64_t steps = (next.time - prev.time) / interval;
+    return steps > 1 ? steps - 1 : 0;
+}
+
+#endif //BARSERIES_H
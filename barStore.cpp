@@ -0,0 +1,94 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "barStore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t columnAlignment = 64;
+
+std::size_t alignUp(std::size_t offset) {
+    return (offset + columnAlignment - 1) & ~(columnAlignment - 1);
+}
+
+} // namespace
+
+void writeBarStore(const std::string& path, std::string_view symbol, timestamp interval,
+                   const data* bars, std::size_t count) {
+    barStoreHeader header{};
+    std::memcpy(header.magic, "BARS", 4);
+    header.version = barStoreVersion;
+    std::memcpy(header.symbol, symbol.data(), std::min(symbol.size(), sizeof(header.symbol) - 1));
+    header.interval = interval;
+    header.rows = count;
+
+    std::size_t offset = sizeof(barStoreHeader);
+    for (std::uint64_t& columnOffset : header.columnOffset) {
+        offset = alignUp(offset);
+        columnOffset = offset;
+        offset += count * sizeof(double);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to create " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // transpose one column at a time through a scratch buffer
+    std::vector<double> values(count);
+    std::vector<timestamp> times(count);
+    std::size_t written = sizeof(barStoreHeader);
+    auto pad = [&](std::size_t to) {
+        static const char zeros[columnAlignment] = {};
+        out.write(zeros, static_cast<std::streamsize>(to - written));
+        written = to;
+    };
+
+    for (std::size_t i = 0; i < count; ++i) times[i] = bars[i].time;
+    pad(header.columnOffset[0]);
+    out.write(reinterpret_cast<const char*>(times.data()), static_cast<std::streamsize>(count * sizeof(timestamp)));
+    written += count * sizeof(timestamp);
+
+    double data::* const fields[5] = {&data::open, &data::high, &data::low, &data::close, &data::volume};
+    for (int c = 0; c < 5; ++c) {
+        for (std::size_t i = 0; i < count; ++i) values[i] = bars[i].*fields[c];
+        pad(header.columnOffset[c + 1]);
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(count * sizeof(double)));
+        written += count * sizeof(double);
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+BarStore::BarStore(const std::string& path) : file(path), header(nullptr) {
+    if (file.size() < sizeof(barStoreHeader)) {
+        throw std::runtime_error(path + " is not a .bars file");
+    }
+    header = reinterpret_cast<const barStoreHeader*>(file.data());
+    if (std::memcmp(header->magic, "BARS", 4) != 0) {
+        throw std::runtime_error(path + " is not a .bars file");
+    }
+    if (header->version != barStoreVersion) {
+        throw std::runtime_error(path + " has unsupported .bars version " + std::to_string(header->version));
+    }
+    for (std::uint64_t offset : header->columnOffset) {
+        if (offset % columnAlignment != 0 || offset > file.size() ||
+            header->rows > (file.size() - offset) / sizeof(double)) {
+            throw std::runtime_error(path + " is truncated or corrupt");
+        }
+    }
+}
+
+std::string_view BarStore::symbol() const {
+    return {header->symbol, strnlen(header->symbol, sizeof(header->symbol))};
+}
@@ -0,0 +1,113 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef BARSTORE_H
+#define BARSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include "data.h"
+#include "mappedFile.h"
+
+/**
+ * @brief On-disk header of a .bars file.
+ *
+ * A .bars file is a columnar store of bars in ascending time order: this 128 byte header
+ * followed by six columns (time, open, high, low, close, volume), each a contiguous array
+ * of `rows` 8-byte values starting on a 64-byte boundary. Integers and doubles are stored
+ * in the writer's native byte order, which the magic/version check guards against mixing.
+ */
+struct barStoreHeader {
+    char magic[4];                 // "BARS"
+    std::uint32_t version;         // barStoreVersion
+    char symbol[16];               // NUL padded
+    std::int64_t interval;         // seconds between bars
+    std::uint64_t rows;
+    std::uint64_t columnOffset[6]; // byte offset of each column from the start of the file
+    std::uint8_t reserved[40];
+};
+static_assert(sizeof(barStoreHeader) == 128, "barStoreHeader must stay 128 bytes");
+
+constexpr std::uint32_t barStoreVersion = 1;
+
+/**
+ * The columns of a .bars file, in file order.
+ */
+enum class barColumn { time, open, high, low, close, volume };
+
+/**
+ * Writes bars to a .bars file.
+ *
+ * @param path The file to create or overwrite.
+ * @param symbol The ticker; at most 15 characters are kept.
+ * @param interval The spacing of the bars in seconds.
+ * @param bars The bars, in ascending time order.
+ * @param count The number of bars.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void writeBarStore(const std::string& path, std::string_view symbol, timestamp interval,
+                   const data* bars, std::size_t count);
+
+/**
+ * @class BarStore
+ * @brief Memory mapped reader for .bars files.
+ *
+ * The columns are handed out as spans straight into the mapping, so opening a store costs
+ * one mmap regardless of its length, and a consumer that only needs closes only touches
+ * the close column.
+ */
+class BarStore {
+public:
+    /**
+     * Maps and validates a .bars file.
+     *
+     * @param path The file to open.
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid .bars file.
+     */
+    explicit BarStore(const std::string& path);
+
+    /**
+     * @return The ticker the bars belong to.
+     */
+    std::string_view symbol() const;
+
+    /**
+     * @return The spacing of the bars in seconds.
+     */
+    timestamp interval() const { return header->interval; }
+
+    /**
+     * @return The number of bars in the store.
+     */
+    std::size_t size() const { return static_cast<std::size_t>(header->rows); }
+
+    std::span<const timestamp> times() const { return {reinterpret_cast<const timestamp*>(columnData(barColumn::time)), size()}; }
+    std::span<const double> opens() const { return column(barColumn::open); }
+    std::span<const double> highs() const { return column(barColumn::high); }
+    std::span<const double> lows() const { return column(barColumn::low); }
+    std::span<const double> closes() const { return column(barColumn::close); }
+    std::span<const double> volumes() const { return column(barColumn::volume); }
+
+    /**
+     * Reassembles one row into a `data` record.
+     *
+     * @param i The row, 0 through size() - 1.
+     * @return The bar at row `i`.
+     */
+    data bar(std::size_t i) const {
+        return {times()[i], opens()[i], closes()[i], highs()[i], lows()[i], volumes()[i]};
+    }
+
+private:
+    MappedFile file;
+    const barStoreHeader* header;
+
+    const char* columnData(barColumn c) const { return file.data() + header->columnOffset[static_cast<int>(c)]; }
+    std::span<const double> column(barColumn c) const { return {reinterpret_cast<const double*>(columnData(c)), size()}; }
+};
+
+#endif //BARSTORE_H
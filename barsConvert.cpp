@@ -0,0 +1,53 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "barCodec.h"
+#include "barSeries.h"
+#include "barStore.h"
+#include "ingest.h"
+#include "mappedFile.h"
+
+/**
+ * Converts recorded Alpha Vantage responses into the columnar .bars format.
+ *
+ * usage: APIEXP_convert <response.json> <output.bars|output.barz>
+ *
+ * A .barz output is written with the compressed bar codec instead of the columnar layout.
+ * Symbol and interval come from the response's "Meta Data" section.
+ */
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <response.json> <output.bars|output.barz>\n";
+        return 2;
+    }
+
+    try {
+        MappedFile file(argv[1]);
+        TimeSeriesScanner scanner(file.view());
+        std::vector<data> bars;
+        rawBar raw;
+        while (scanner.next(raw)) {
+            bars.push_back(parseBar(raw));
+        }
+        sortBars(bars.data(), bars.data() + bars.size());
+
+        timestamp interval = parseInterval(scanner.meta().interval);
+        if (interval == 0) interval = barInterval;
+        const std::string output = argv[2];
+        if (output.ends_with(".barz")) {
+            writeCompressedBars(output, scanner.meta().symbol, interval, bars.data(), bars.size());
+        } else {
+            writeBarStore(output, scanner.meta().symbol, interval, bars.data(), bars.size());
+        }
+
+        std::cout << "Wrote " << bars.size() << " " << scanner.meta().symbol << " bars to " << argv[2] << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -3,6 +3,1122 @@
 //
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
+#include <cstdio>
+#include "alphaVantageClient.h"
+#include "asyncFetcher.h"
+#include "backfill.h"
+#include "barCache.h"
+#include "barCodec.h"
+#include "barColumns.h"
+#include "barSeries.h"
+#include "barStore.h"
+#include "circularDeque.h"
+#include "decimalParse.h"
+#include "ExactMovingAvg.h"
+#include "ingest.h"
+#include "mappedFile.h"
+#include "MovingAvg.h"
+#include "MpmcQueue.h"
+#include "pollMerger.h"
+#include "requestScheduler.h"
+#include "responseLog.h"
+#include "RollingWindow.h"
+#include "SpscRing.h"
+#include "standinServer.h"
+#include "StaticMovingAvg.h"
 
+TEST(Timestamp, RoundTripsFeedKeys) {
+    const timestamp t = parseTimestamp("2025-05-12 19:50:00");
+    EXPECT_EQ(t % 86400, 19 * 3600 + 50 * 60);
+    EXPECT_EQ(formatTimestamp(t), "2025-05-12 19:50:00");
+    EXPECT_EQ(parseTimestamp("2025-05-12 19:55:00") - t, 300);
+    EXPECT_THROW(parseTimestamp("2025-05-12 19:5"), std::runtime_error);
+    EXPECT_THROW(parseTimestamp("2025-13-12 19:50:00"), std::runtime_error);
+    EXPECT_THROW(parseTimestamp("2025-05-12T19:50:00"), std::runtime_error);
+    EXPECT_EQ(parseTimestamp("2024-02-29"), parseTimestamp("2024-02-29 00:00:00"));
+    EXPECT_EQ(parseTimestamp("2000-02-29") + 86400, parseTimestamp("2000-03-01"));
+    EXPECT_THROW(parseTimestamp("2024-02-31"), std::runtime_error);
+    EXPECT_THROW(parseTimestamp("2023-02-29"), std::runtime_error);
+    EXPECT_THROW(parseTimestamp("1900-02-29"), std::runtime_error);
+    EXPECT_THROW(parseTimestamp("2025-04-31 09:30:00"), std::runtime_error);
+    EXPECT_THROW(parseTimestamp("2025-05-00 09:30:00"), std::runtime_error);
+    EXPECT_EQ(formatTimestamp(parseTimestamp("2025-12-31 09:30:00")), "2025-12-31 09:30:00");
+    EXPECT_EQ(formatTimestamp(parseTimestamp("1969-12-31 23:55:00")), "1969-12-31 23:55:00");
+}
 
+TEST(BarSeries, OrdersLooksUpAndFindsGaps) {
+    const timestamp t0 = parseTimestamp("2025-05-12 19:30:00");
+    data bars[] = {data(t0 + 900, 1, 1, 1, 1, 1), data(t0 + 300, 2, 2, 2, 2, 2), data(t0, 3, 3, 3, 3, 3)};
+    sortBars(bars, bars + 3);
+    EXPECT_EQ(bars[0].time, t0);
+    EXPECT_EQ(bars[2].time, t0 + 900);
+
+    ASSERT_NE(findBar(bars, bars + 3, t0 + 300), nullptr);
+    EXPECT_EQ(findBar(bars, bars + 3, t0 + 300)->open, 2);
+    EXPECT_EQ(findBar(bars, bars + 3, t0 + 600), nullptr);
+
+    EXPECT_EQ(missingBars(bars[0], bars[1]), 0);
+    EXPECT_EQ(missingBars(bars[1], bars[2]), 1);
+}
+
+TEST(Ingest, StreamsBarsInFeedOrder) {
+    const std::string feed = R"json({
+        "Meta Data": {"2. Symbol": "IBM", "4. Interval": "5min"},
+        "Time Series (5min)": {
+            "2025-05-12 19:50:00": {"1. open": "253.1100", "2. high": "253.2000", "3. low": "253.0000", "4. close": "253.1500", "5. volume": "3"},
+            "2025-05-12 19:45:00": {"1. open": "253.0000", "2. high": "253.1100", "3. low": "252.9000", "4. close": "253.1100", "5. volume": "17"}
+        }
+    })json";
+    data bars[2];
+    ASSERT_EQ(ingestTimeSeries(feed, bars, 2), 2u);
+    EXPECT_EQ(bars[0].time, parseTimestamp("2025-05-12 19:50:00"));
+    EXPECT_DOUBLE_EQ(bars[0].open, 253.11);
+    EXPECT_DOUBLE_EQ(bars[0].high, 253.2);
+    EXPECT_DOUBLE_EQ(bars[0].low, 253.0);
+    EXPECT_DOUBLE_EQ(bars[0].close, 253.15);
+    EXPECT_DOUBLE_EQ(bars[1].volume, 17);
+
+    // a short buffer keeps the newest bars
+    data newest[1];
+    EXPECT_EQ(ingestTimeSeries(feed, newest, 1), 1u);
+    EXPECT_EQ(newest[0].time, bars[0].time);
+
+    EXPECT_EQ(ingestTimeSeries(std::string(R"({"Note": "rate limited"})"), bars, 2), 0u);
+
+    // the SAX stream path and the in-place scanner agree
+    std::istringstream stream(feed);
+    data streamed[2];
+    ASSERT_EQ(ingestTimeSeries(stream, streamed, 2), 2u);
+    EXPECT_EQ(streamed[1].time, bars[1].time);
+    EXPECT_DOUBLE_EQ(streamed[1].low, bars[1].low);
+
+    // a bar missing a field is rejected by both paths rather than read as zero
+    const std::string missing = R"json({"Time Series (5min)": {
+        "2025-05-12 19:50:00": {"1. open": "253.1100", "3. low": "253.0000", "4. close": "253.1500", "5. volume": "3"}
+    }})json";
+    EXPECT_THROW(ingestTimeSeries(missing, bars, 2), std::runtime_error);
+    std::istringstream missingStream(missing);
+    EXPECT_THROW(ingestTimeSeries(missingStream, streamed, 2), std::runtime_error);
+}
+
+TEST(Ingest, LoadsWholeMappedFiles) {
+    const std::string path = ::testing::TempDir() + "mapped.json";
+    const auto write = [&](const std::string& text) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+    };
+
+    write("");
+    EXPECT_EQ(MappedFile(path).size(), 0u);
+    EXPECT_TRUE(loadBars(path).empty());
+
+    // no newline after the closing brace, and more bars than the old fixed buffer held
+    std::string feed = R"json({"Time Series (5min)": {)json";
+    const timestamp t0 = parseTimestamp("2025-05-12 04:00:00");
+    const std::size_t count = 70000;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i) feed += ',';
+        feed += '"' + formatTimestamp(t0 - static_cast<timestamp>(i) * 300) +
+                R"json(": {"1. open": "1.5", "2. high": "2", "3. low": "1", "4. close": "1.75", "5. volume": "9"})json";
+    }
+    feed += "}}";
+    write(feed);
+
+    MappedFile file(path);
+    EXPECT_EQ(file.view(), feed);
+    const std::vector<data> bars = loadBars(path);
+    ASSERT_EQ(bars.size(), count);
+    EXPECT_EQ(bars.front().time, t0);
+    EXPECT_EQ(bars.back().time, t0 - static_cast<timestamp>(count - 1) * 300);
+    EXPECT_DOUBLE_EQ(bars.back().close, 1.75);
+
+    // a document cut off mid bar is reported, not silently shortened
+    write(feed.substr(0, feed.size() - 20));
+    EXPECT_THROW(loadBars(path), std::runtime_error);
+
+    EXPECT_THROW(MappedFile(path + ".missing"), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(DecimalParse, FixedFormatMatchesFromChars) {
+    std::int64_t fixed;
+    ASSERT_TRUE(parseFixed4("253.1100", fixed));
+    EXPECT_EQ(fixed, 2531100);
+    ASSERT_TRUE(parseFixed4("0.5", fixed));
+    EXPECT_EQ(fixed, 5000);
+    EXPECT_FALSE(parseFixed4("1.23456", fixed));
+    EXPECT_FALSE(parseFixed4("-1.0", fixed));
+
+    for (const char* text : {"253.1100", "251.8270", "0.0001", "99999999.9999", "1.23456", "2.5e3"}) {
+        EXPECT_EQ(parsePrice(text), std::stod(text)) << text;
+    }
+    EXPECT_EQ(parseVolume("30278"), 30278.0);
+    EXPECT_EQ(parseVolume("1234567890123456"), 1234567890123456.0);
+    EXPECT_EQ(parseVolume("12345678901234567890"), 12345678901234567890.0);
+    EXPECT_THROW(parseVolume(""), std::runtime_error);
+    EXPECT_THROW(parsePrice("12a.5"), std::runtime_error);
+    for (const char* text : {"nan", "inf", "-inf", "NaN", "infinity", "1e400"}) {
+        EXPECT_THROW(parsePrice(text), std::runtime_error) << text;
+        EXPECT_THROW(parseVolume(text), std::runtime_error) << text;
+    }
+}
+
+TEST(BarStore, RoundTripsColumns) {
+    const timestamp t0 = parseTimestamp("2025-05-12 19:30:00");
+    const data bars[] = {data(t0, 253.5, 253.6753, 253.6753, 253.5, 22), data(t0 + 300, 253.11, 253.11, 253.11, 253.11, 1)};
+    const std::string path = ::testing::TempDir() + "roundtrip.bars";
+    writeBarStore(path, "IBM", barInterval, bars, 2);
+
+    BarStore store(path);
+    EXPECT_EQ(store.symbol(), "IBM");
+    EXPECT_EQ(store.interval(), barInterval);
+    ASSERT_EQ(store.size(), 2u);
+    EXPECT_EQ(store.times()[1], t0 + 300);
+    EXPECT_EQ(store.closes()[0], 253.6753);
+    EXPECT_EQ(store.volumes()[0], 22);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(store.closes().data()) % 64, 0u);
+    EXPECT_EQ(store.bar(1).high, 253.11);
+    std::remove(path.c_str());
+}
+
+TEST(BarCodec, DecodesWhatItEncodes) {
+    const timestamp t0 = parseTimestamp("2025-05-12 19:00:00");
+    std::vector<data> bars;
+    for (int i = 0; i < 50; ++i) {
+        // prices as the feed parses them, whole ten-thousandths
+        const std::int64_t open = 2531100 + (i % 7) * 125;
+        auto price = [](std::int64_t fixed) { return static_cast<double>(fixed) / 10000.0; };
+        bars.emplace_back(t0 + 300 * (i + (i > 20)), price(open), price(open - 100), price(open + 253), price(open - 1000), 100 + i * 37);
+    }
+
+    BarEncoder encoder;
+    for (const data& bar : bars) encoder.add(bar);
+    EXPECT_LT(encoder.bytes().size(), bars.size() * sizeof(data) / 4);
+
+    BarDecoder decoder(encoder.bytes(), encoder.size());
+    data bar;
+    for (const data& expected : bars) {
+        ASSERT_TRUE(decoder.next(bar));
+        EXPECT_EQ(bar.time, expected.time);
+        EXPECT_EQ(bar.open, expected.open);
+        EXPECT_EQ(bar.high, expected.high);
+        EXPECT_EQ(bar.low, expected.low);
+        EXPECT_EQ(bar.close, expected.close);
+        EXPECT_EQ(bar.volume, expected.volume);
+    }
+    EXPECT_FALSE(decoder.next(bar));
+
+    // values the fixed-point scale cannot hold are refused, not rounded
+    EXPECT_THROW(encoder.add(data(t0 + 300 * 60, 1.23456, 1, 1, 1, 1)), std::runtime_error);
+    EXPECT_THROW(encoder.add(data(t0 + 300 * 60, 1, 1, 1, 1, 2.5)), std::runtime_error);
+    EXPECT_EQ(encoder.size(), bars.size());
+
+    // a varint that never ends within 64 bits is corruption, not a shift past the word
+    const std::vector<std::uint8_t> corrupt(12, 0xFF);
+    BarDecoder broken(corrupt, 1);
+    EXPECT_THROW(broken.next(bar), std::runtime_error);
+    // nine continuation bytes leave one bit; a tenth byte carrying more has overflowed
+    std::vector<std::uint8_t> overflow(9, 0x80);
+    overflow.push_back(0x02);
+    BarDecoder overflowed(overflow, 1);
+    EXPECT_THROW(overflowed.next(bar), std::runtime_error);
+    const std::vector<std::uint8_t> truncated(3, 0x80);
+    BarDecoder cut(truncated, 1);
+    EXPECT_THROW(cut.next(bar), std::runtime_error);
+}
+
+TEST(RequestScheduler, SpendsQuotaOnStalestSymbolsFirst) {
+    using namespace std::chrono_literals;
+    auto now = RequestScheduler::clock::time_point();
+    RequestScheduler scheduler(rateQuota{2, 100}, now);
+
+    EXPECT_TRUE(scheduler.submit("IBM", 300, now));
+    EXPECT_TRUE(scheduler.submit("LMT", 100, now));
+    EXPECT_TRUE(scheduler.submit("NOC", 200, now));
+    EXPECT_FALSE(scheduler.submit("IBM", 50, now));
+    EXPECT_EQ(scheduler.queueDepth(), 3u);
+
+    EXPECT_EQ(scheduler.poll(now), "IBM");
+    EXPECT_EQ(scheduler.poll(now), "LMT");
+    EXPECT_EQ(scheduler.poll(now), std::nullopt);
+    EXPECT_EQ(scheduler.timeUntilNext(now), 30s);
+
+    now += 30s;
+    EXPECT_EQ(scheduler.poll(now), "NOC");
+    EXPECT_EQ(scheduler.timeUntilNext(now), RequestScheduler::clock::duration::max());
+
+    const schedulerStats stats = scheduler.stats();
+    EXPECT_EQ(stats.dispatched, 3u);
+    EXPECT_EQ(stats.coalesced, 1u);
+    EXPECT_EQ(stats.maxWaitMs, 30000);
+
+    EXPECT_THROW(RequestScheduler(rateQuota{0, 100}, now), std::invalid_argument);
+    EXPECT_THROW(RequestScheduler(rateQuota{5, 0}, now), std::invalid_argument);
+    EXPECT_THROW(RequestScheduler(rateQuota{0.5, 25}, now), std::invalid_argument);
+    EXPECT_THROW(RequestScheduler(rateQuota{5, 0.9}, now), std::invalid_argument);
+    EXPECT_NO_THROW(RequestScheduler(rateQuota{1, 1.5}, now));
+}
+
+TEST(PollMerger, AppendsOnlyNewBarsAndReportsRevisions) {
+    auto response = [](const std::string& bars) {
+        return R"json({"Meta Data": {"3. Last Refreshed": "2025-05-12 19:50:00"}, "Time Series (5min)": {)json" + bars + "}}";
+    };
+    auto bar = [](const std::string& time, const std::string& close) {
+        return "\"" + time + R"json(": {"1. open": "1.0000", "2. high": "2.0000", "3. low": "0.5000", "4. close": ")json" + close + R"json(", "5. volume": "10"})json";
+    };
+
+    PollMerger merger;
+    std::vector<data> appended;
+    auto append = [&](const data& d) { appended.push_back(d); };
+
+    mergeResult first = merger.merge("IBM", response(bar("2025-05-12 19:45:00", "1.5000") + "," + bar("2025-05-12 19:40:00", "1.4000")), append);
+    EXPECT_EQ(first.appended, 2u);
+    ASSERT_EQ(appended.size(), 2u);
+    EXPECT_LT(appended[0].time, appended[1].time);
+    EXPECT_EQ(first.lastRefreshed, parseTimestamp("2025-05-12 19:50:00"));
+
+    mergeResult second = merger.merge("IBM", response(bar("2025-05-12 19:50:00", "1.6000") + "," + bar("2025-05-12 19:45:00", "1.5500") + "," +
+                                                      bar("2025-05-12 19:40:00", "1.4000") + "," + bar("2025-05-12 19:35:00", "1.3000")), append);
+    EXPECT_EQ(second.appended, 1u);
+    EXPECT_EQ(second.scanned, 3u);
+    ASSERT_EQ(appended.size(), 3u);
+    EXPECT_EQ(appended[2].close, 1.6);
+    ASSERT_EQ(second.revisions.size(), 1u);
+    EXPECT_EQ(second.revisions[0].previous.close, 1.5);
+    EXPECT_EQ(second.revisions[0].revised.close, 1.55);
+    EXPECT_EQ(merger.lastIngested("IBM"), parseTimestamp("2025-05-12 19:50:00"));
+}
+
+TEST(ResponseLog, ReplaysRecordedResponsesPerSymbol) {
+    const std::string path = ::testing::TempDir() + "responses.jsonl";
+    std::remove(path.c_str());
+    {
+        ResponseRecorder recorder(path);
+        recorder.record({1000, "IBM", 120.5, 200, R"json({"Note": "first"})json"});
+        recorder.record({1500, "LMT", 80, 200, "{}"});
+        recorder.record({2000, "IBM", 95, 429, "line\nbreak"});
+    }
+
+    ResponseReplayer replayer(path);
+    EXPECT_EQ(replayer.size(), 3u);
+    std::optional<recordedResponse> ibm = replayer.fetch("IBM");
+    ASSERT_TRUE(ibm);
+    EXPECT_EQ(ibm->body, R"json({"Note": "first"})json");
+    EXPECT_EQ(ibm->latencyMs, 120.5);
+    ibm = replayer.fetch("IBM");
+    ASSERT_TRUE(ibm);
+    EXPECT_EQ(ibm->status, 429);
+    EXPECT_EQ(ibm->body, "line\nbreak");
+    EXPECT_FALSE(replayer.fetch("IBM"));
+    EXPECT_FALSE(replayer.fetch("NOC"));
+
+    EXPECT_EQ(replayer.next()->symbol, "IBM");
+    EXPECT_EQ(replayer.next()->symbol, "LMT");
+    std::remove(path.c_str());
+}
+
+TEST(ResponseLog, ReplaysThroughEveryFetchPath) {
+    const std::string path = ::testing::TempDir() + "replay-paths.jsonl";
+    std::remove(path.c_str());
+    {
+        ResponseRecorder recorder(path);
+        recorder.record({1000, "IBM", 10, 200, "ibm-1"});
+        recorder.record({1100, "LMT", 10, 200, "lmt-1"});
+        recorder.record({1200, "IBM", 10, 200, "ibm-2"});
+        recorder.record({1300, "NOC", 10, 200, "noc-1"});
+    }
+    ResponseReplayer replayer(path);
+    setResponseReplayer(&replayer);
+
+    // nothing listens on the discard port, so any request that reached the network would fail
+    const std::string unreachable = "http://127.0.0.1:9/query";
+    std::vector<std::pair<std::string, cpr::Response>> batch;
+    fetchAll({"IBM", "LMT", "GD"}, [&](const std::string& symbol, const cpr::Response& response) {
+        batch.emplace_back(symbol, response);
+    }, unreachable);
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch[0].second.text, "ibm-1");
+    EXPECT_EQ(batch[1].second.text, "lmt-1");
+    EXPECT_EQ(batch[2].second.status_code, 404);
+
+    AlphaVantageClient client(2, unreachable, "demo");
+    EXPECT_EQ(client.fetchIntraday("IBM").text, "ibm-2");
+    EXPECT_EQ(client.fetchIntraday("IBM").status_code, 404);
+    EXPECT_EQ(fetchIntraday("NOC").text, "noc-1");
+    EXPECT_EQ(fetchIntradayMonth("LMT", "2025-04").status_code, 404);
+    EXPECT_FALSE(client.fetchIntraday("LMT").error);
+
+    setResponseReplayer(nullptr);
+    std::remove(path.c_str());
+}
+
+TEST(StandinServer, ServesIntradayResponsesOverLoopback) {
+    standinOptions options;
+    options.compactBars = 12;
+    options.rateLimitEvery = 2;
+    StandinServer server(options);
+    server.start();
+
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(server.port());
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+
+    // reads one response off the connection and returns its body
+    auto exchange = [fd](const std::string& request) {
+        ::send(fd, request.data(), request.size(), 0);
+        std::string received;
+        char chunk[4096];
+        std::size_t headerEnd;
+        while ((headerEnd = received.find("\r\n\r\n")) == std::string::npos) {
+            const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) return std::string();
+            received.append(chunk, static_cast<std::size_t>(n));
+        }
+        const std::size_t lengthAt = received.find("Content-Length: ") + 16;
+        const std::size_t length = std::stoul(received.substr(lengthAt, received.find("\r\n", lengthAt) - lengthAt));
+        while (received.size() < headerEnd + 4 + length) {
+            const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) return std::string();
+            received.append(chunk, static_cast<std::size_t>(n));
+        }
+        return received.substr(headerEnd + 4, length);
+    };
+
+    // two requests on one kept-alive connection; the second is rate limited
+    const std::string request = "GET /query?function=TIME_SERIES_INTRADAY&symbol=IBM&interval=5min&apikey=demo HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    const std::string body = exchange(request);
+    data bars[20];
+    ASSERT_EQ(ingestTimeSeries(body, bars, 20), 12u);
+    EXPECT_EQ(bars[0].time - bars[1].time, barInterval);
+    EXPECT_GE(bars[0].high, bars[0].low);
+
+    const std::string limited = exchange(request);
+    EXPECT_NE(limited.find("\"Note\""), std::string::npos);
+
+    // malformed escapes are answered with a 400 and the connection stays usable
+    EXPECT_NE(exchange("GET /query?function=TIME_SERIES_INTRADAY&symbol=%zz&interval=5min HTTP/1.1\r\n\r\n").find("Malformed"), std::string::npos);
+    EXPECT_NE(exchange("GET /query?symbol=IBM&apikey=%4 HTTP/1.1\r\n\r\n").find("Malformed"), std::string::npos);
+    ::close(fd);
+    EXPECT_THROW(server.render("function=TIME_SERIES_INTRADAY&symbol=%g1&interval=5min"), std::invalid_argument);
+    EXPECT_NE(server.render("function=TIME_SERIES_INTRADAY&symbol=%49BM&interval=5min").find("\"2. Symbol\": \"IBM\""), std::string::npos);
+
+    // short-lived connections come and go; their threads are joined along the way
+    for (int i = 0; i < 20; ++i) {
+        const int shortLived = ::socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_EQ(::connect(shortLived, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+        ::close(shortLived);
+    }
+
+    server.stop();
+    EXPECT_EQ(server.stats().requests, 4u);
+    EXPECT_EQ(server.stats().rateLimited, 1u);
+}
+
+TEST(AsyncFetcher, DeliversResponsesAsTheyComplete) {
+    standinOptions options;
+    options.compactBars = 3;
+    options.slowSymbol = "SLOW";
+    options.slowMs = 300;
+    StandinServer server(options);
+    server.start();
+
+    const std::thread::id caller = std::this_thread::get_id();
+    std::vector<std::string> order;
+    fetchAll({"SLOW", "IBM", "LMT"}, [&](const std::string& symbol, const cpr::Response& response) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        EXPECT_EQ(response.status_code, 200) << symbol;
+        EXPECT_NE(response.text.find("\"2. Symbol\": \"" + symbol + "\""), std::string::npos) << symbol;
+        order.push_back(symbol);
+    }, server.url());
+    ASSERT_EQ(order.size(), 3u);
+    // the slow symbol was issued first but completes last
+    EXPECT_EQ(order.back(), "SLOW");
+    EXPECT_EQ(server.stats().requests, 3u);
+
+    // a handler that throws still leaves no transfer running against this frame
+    EXPECT_THROW(fetchAll({"SLOW", "IBM"}, [](const std::string&, const cpr::Response&) {
+        throw std::runtime_error("handler failed");
+    }, server.url()), std::runtime_error);
+    server.stop();
+
+    standinOptions failing;
+    failing.errorRate = 1;
+    StandinServer broken(failing);
+    broken.start();
+    std::vector<long> statuses;
+    fetchAll({"IBM", "LMT"}, [&](const std::string&, const cpr::Response& response) {
+        statuses.push_back(response.status_code);
+    }, broken.url());
+    EXPECT_EQ(statuses, std::vector<long>({500, 500}));
+    broken.stop();
+
+    // nothing listens on the discard port: a transport error, delivered like any response
+    std::size_t failures = 0;
+    fetchAll({"IBM"}, [&](const std::string&, const cpr::Response& response) {
+        failures += response.error && response.status_code == 0;
+    }, "http://127.0.0.1:9/query");
+    EXPECT_EQ(failures, 1u);
+}
+
+TEST(AlphaVantageClient, ReusesPooledSessionsAndTimesFetches) {
+    standinOptions options;
+    options.compactBars = 3;
+    options.latencyMs = 50;
+    StandinServer server(options);
+    server.start();
+
+    // sequential fetches ride one keep-alive connection
+    AlphaVantageClient single(1, server.url(), "demo");
+    for (const char* symbol : {"IBM", "LMT", "IBM"}) {
+        const cpr::Response response = single.fetchIntraday(symbol);
+        EXPECT_EQ(response.status_code, 200);
+        EXPECT_NE(response.text.find(std::string("\"2. Symbol\": \"") + symbol + "\""), std::string::npos);
+    }
+    EXPECT_EQ(server.stats().connections, 1u);
+    EXPECT_EQ(server.stats().requests, 3u);
+
+    fetchLatency latency = single.latency();
+    EXPECT_EQ(latency.count, 3u);
+    EXPECT_GE(latency.minMs, 50);
+    EXPECT_GE(latency.maxMs, latency.minMs);
+    EXPECT_GE(latency.meanMs(), latency.minMs);
+    EXPECT_LE(latency.meanMs(), latency.maxMs);
+    EXPECT_NEAR(latency.totalMs, latency.meanMs() * 3, 1e-9);
+
+    // eight callers share two sessions, so the server never sees more than two connections
+    AlphaVantageClient pooled(2, server.url(), "demo");
+    std::vector<std::thread> callers;
+    std::atomic<int> ok = 0;
+    for (int i = 0; i < 8; ++i) {
+        callers.emplace_back([&pooled, &ok, i] {
+            ok += pooled.fetchIntraday(i % 2 ? "IBM" : "NOC").status_code == 200;
+        });
+    }
+    for (std::thread& caller : callers) caller.join();
+    EXPECT_EQ(ok, 8);
+    EXPECT_LE(server.stats().connections, 1u + 2u);
+    EXPECT_EQ(server.stats().requests, 11u);
+    EXPECT_EQ(pooled.latency().count, 8u);
+    server.stop();
+
+    // cached query URLs are cpr-encoded and stay correct once the bounded cache starts evicting
+    standinOptions quick;
+    quick.compactBars = 1;
+    StandinServer fast(quick);
+    fast.start();
+    AlphaVantageClient many(1, fast.url(), "demo");
+    EXPECT_NE(many.fetchIntraday("BRK B").text.find("\"2. Symbol\": \"BRK B\""), std::string::npos);
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_EQ(many.fetchIntraday("S" + std::to_string(i)).status_code, 200);
+    }
+    EXPECT_NE(many.fetchIntraday("BRK B").text.find("\"2. Symbol\": \"BRK B\""), std::string::npos);
+    EXPECT_NE(many.fetchIntraday("S299").text.find("\"2. Symbol\": \"S299\""), std::string::npos);
+    EXPECT_EQ(fast.stats().connections, 1u);
+    fast.stop();
+}
+
+TEST(BarCache, ServesClosedDaysFromDisk) {
+    // hourly bars 10:00 through 15:00, Monday 2026-10-12 through Friday, then Monday morning
+    const std::int64_t monday = daysFromCivil(2026, 10, 12);
+    std::string body = R"json({"Meta Data": {"2. Symbol": "IBM"}, "Time Series (5min)": {)json";
+    for (std::int64_t day = monday + 7; day >= monday; --day) {
+        if (day == monday + 5 || day == monday + 6) continue;
+        for (int hour = day == monday + 7 ? 12 : 15; hour >= 10; --hour) {
+            const double price = 100 + static_cast<double>(day - monday) + hour / 100.0;
+            body += (body.back() == '{' ? "\"" : ",\"") + formatTimestamp(day * 86400 + hour * 3600) +
+                    "\": {\"1. open\": \"" + std::to_string(price) + "\", \"2. high\": \"" + std::to_string(price) +
+                    "\", \"3. low\": \"" + std::to_string(price) + "\", \"4. close\": \"" + std::to_string(price) +
+                    "\", \"5. volume\": \"" + std::to_string(hour) + "\"}";
+        }
+    }
+    body += "}}";
+
+    const std::filesystem::path root = ::testing::TempDir() + "barcache";
+    std::filesystem::remove_all(root);
+    BarCache cache(root);
+    int fetches = 0;
+    auto fetch = [&](const std::string&) {
+        fetches++;
+        return body;
+    };
+    const timestamp now = (monday + 7) * 86400 + 12 * 3600 + 30 * 60;
+
+    const std::vector<data> first = cache.bars("IBM", monday + 1, monday + 7, now, fetch);
+    EXPECT_EQ(fetches, 1);
+    ASSERT_EQ(first.size(), 4 * 6 + 3u);
+    EXPECT_TRUE(std::is_sorted(first.begin(), first.end(), [](const data& a, const data& b) { return a.time < b.time; }));
+    // the oldest fetched day may be cut off and the open day is still trading
+    EXPECT_FALSE(cache.contains("IBM", monday));
+    EXPECT_TRUE(cache.contains("IBM", monday + 6));
+    EXPECT_FALSE(cache.contains("IBM", monday + 7));
+    EXPECT_EQ(cache.stats().daysWritten, 6u);
+    EXPECT_EQ(cache.pathFor("IBM", monday + 1), root / "IBM" / "5min" / "2026-10-13.bars");
+
+    const std::vector<data> closed = cache.bars("IBM", monday + 1, monday + 6, now, fetch);
+    EXPECT_EQ(fetches, 1);
+    EXPECT_EQ(cache.stats().dayHits, 6u);
+    ASSERT_EQ(closed.size(), 4 * 6u);
+    EXPECT_EQ(closed.back().time, first[23].time);
+    EXPECT_EQ(closed.back().close, first[23].close);
+
+    cache.bars("IBM", monday + 6, monday + 7, now, fetch);
+    EXPECT_EQ(fetches, 2);
+    std::filesystem::remove_all(root);
+}
+
+TEST(BarCache, FillsClosedDaysThroughCachedIntraday) {
+    // the stand-in serves round-the-clock bars ending at the current slot; four days of them
+    standinOptions options;
+    options.fullBars = 4 * 288;
+    StandinServer server(options);
+    server.start();
+
+    const std::filesystem::path root = ::testing::TempDir() + "cachedintraday";
+    std::filesystem::remove_all(root);
+    BarCache cache(root);
+    const std::int64_t today = dayOf(feedNow());
+
+    const std::vector<data> first = cachedIntraday(cache, "IBM", today - 2, today, server.url());
+    EXPECT_EQ(server.stats().requests, 1u);
+    EXPECT_TRUE(cache.contains("IBM", today - 3));
+    EXPECT_TRUE(cache.contains("IBM", today - 1));
+    EXPECT_FALSE(cache.contains("IBM", today));
+    ASSERT_GT(first.size(), 2 * 288u);
+
+    // closed days are now served from disk alone
+    const std::vector<data> closed = cachedIntraday(cache, "IBM", today - 3, today - 1, server.url());
+    EXPECT_EQ(server.stats().requests, 1u);
+    ASSERT_EQ(closed.size(), 3 * 288u);
+    EXPECT_EQ(closed.back().time, first[2 * 288 - 1].time);
+    EXPECT_EQ(cache.stats().fetches, 1u);
+
+    // symbols that would leave the cache root or overflow the .bars header are refused before any fetch
+    EXPECT_THROW(cachedIntraday(cache, "../IBM", today - 1, today, server.url()), std::invalid_argument);
+    EXPECT_THROW(cachedIntraday(cache, "ABCDEFGHIJKLMNOP", today - 1, today, server.url()), std::invalid_argument);
+    EXPECT_THROW(cache.pathFor("", today), std::invalid_argument);
+    EXPECT_NO_THROW(cache.pathFor("BRK.B", today));
+    EXPECT_EQ(server.stats().requests, 1u);
+    server.stop();
+    std::filesystem::remove_all(root);
+}
+
+TEST(Backfill, MergesMonthSlicesInOrder) {
+    EXPECT_EQ(monthRange("2025-11", "2026-02"), (std::vector<std::string>{"2025-11", "2025-12", "2026-01", "2026-02"}));
+    EXPECT_TRUE(monthRange("2026-02", "2026-01").empty());
+    EXPECT_THROW(monthRange("2026-13", "2026-12"), std::runtime_error);
+
+    // each slice holds the first and last day of its month at 16:00, plus the next month's
+    // first bar to overlap with the following slice
+    auto fetch = [](const std::string& symbol, const std::string& month) {
+        const int year = std::stoi(month.substr(0, 4));
+        const unsigned m = static_cast<unsigned>(std::stoi(month.substr(5, 2)));
+        const std::int64_t first = daysFromCivil(year, m, 1);
+        const std::int64_t next = m == 12 ? daysFromCivil(year + 1, 1, 1) : daysFromCivil(year, m + 1, 1);
+        std::string body = R"json({"Meta Data": {"2. Symbol": ")json" + symbol + R"json("}, "Time Series (5min)": {)json";
+        for (std::int64_t day : {next, next - 1, first}) {
+            const std::string price = symbol == "IBM" ? "200.0000" : "500.0000";
+            body += (body.back() == '{' ? "\"" : ",\"") + formatTimestamp(day * 86400 + 16 * 3600) +
+                    "\": {\"1. open\": \"" + price + "\", \"2. high\": \"" + price + "\", \"3. low\": \"" +
+                    price + "\", \"4. close\": \"" + price + "\", \"5. volume\": \"1\"}";
+        }
+        return body + "}}";
+    };
+
+    BackfillLoader loader(3);
+    const std::vector<std::string> months = monthRange("2025-11", "2026-02");
+    const auto all = loader.loadAll({"IBM", "LMT"}, months, fetch);
+    ASSERT_EQ(all.at("IBM").size(), 4 * 2 + 1u);
+    EXPECT_TRUE(std::is_sorted(all.at("IBM").begin(), all.at("IBM").end(), [](const data& a, const data& b) { return a.time < b.time; }));
+    EXPECT_EQ(formatTimestamp(all.at("IBM").front().time), "2025-11-01 16:00:00");
+    EXPECT_EQ(formatTimestamp(all.at("IBM").back().time), "2026-03-01 16:00:00");
+    EXPECT_EQ(all.at("LMT").front().close, 500);
+    EXPECT_EQ(loader.load("IBM", months, fetch).size(), 9u);
+
+    EXPECT_THROW(loader.load("IBM", months, [](const std::string&, const std::string&) -> std::string {
+        throw std::runtime_error("quota");
+    }), std::runtime_error);
+
+    const std::vector<std::vector<data>> runs = {
+        {data(1, 1, 1, 1, 1, 1), data(3, 1, 1, 1, 1, 1)},
+        {data(2, 2, 2, 2, 2, 2), data(3, 2, 2, 2, 2, 2)},
+    };
+    const std::vector<data> merged = mergeRuns(runs);
+    ASSERT_EQ(merged.size(), 3u);
+    EXPECT_EQ(merged[2].close, 2); // the later run wins an overlap
+}
+
+TEST(Backfill, LoadsRecordedMonthsThroughResponseSlices) {
+    // one bar per month, on its first day, closing at the month number
+    auto slice = [](const std::string& month) {
+        const unsigned m = static_cast<unsigned>(std::stoi(month.substr(5, 2)));
+        const std::string price = std::to_string(m) + ".0000";
+        return R"json({"Time Series (5min)": {")json" + formatTimestamp(daysFromCivil(std::stoi(month.substr(0, 4)), m, 1) * 86400 + 16 * 3600) +
+               R"json(": {"1. open": ")json" + price + R"json(", "2. high": ")json" + price + R"json(", "3. low": ")json" + price +
+               R"json(", "4. close": ")json" + price + R"json(", "5. volume": "1"}}})json";
+    };
+    const std::string path = ::testing::TempDir() + "backfill-replay.jsonl";
+    std::remove(path.c_str());
+    {
+        ResponseRecorder recorder(path);
+        recorder.record({1000, "IBM", 5, 200, slice("2025-12"), "2025-12"});
+        recorder.record({1100, "IBM", 5, 200, slice("2025-11"), "2025-11"});
+        recorder.record({1200, "IBM", 5, 200, R"json({"Time Series (5min)": {}})json"});
+        recorder.record({1300, "IBM", 5, 200, R"json({"Note": "Thank you for using Alpha Vantage!"})json", "2026-02"});
+        recorder.record({1400, "IBM", 5, 200, R"json({"Error Message": "Invalid API call."})json", "2026-03"});
+    }
+
+    ResponseReplayer replayer(path);
+    setResponseReplayer(&replayer);
+    const sliceFetch slices = responseSliceFetch([](const std::string& symbol, const std::string& month) {
+        return fetchIntradayMonth(symbol, month, "http://127.0.0.1:9/query");
+    });
+    BackfillLoader loader(2);
+    // every month gets its own recording, not the first one logged for the symbol
+    const std::vector<data> bars = loader.load("IBM", {"2025-11", "2025-12"}, slices);
+    ASSERT_EQ(bars.size(), 2u);
+    EXPECT_EQ(bars[0].close, 11);
+    EXPECT_EQ(bars[1].close, 12);
+    // a month without a recording replays as a 404, which the adapter turns into a failure
+    EXPECT_THROW(loader.load("IBM", {"2026-01"}, slices), std::runtime_error);
+    // throttled and rejected calls come back with HTTP 200 but must not merge as empty months
+    EXPECT_THROW(loader.load("IBM", {"2026-02"}, slices), std::runtime_error);
+    EXPECT_THROW(loader.load("IBM", {"2026-03"}, slices), std::runtime_error);
+    setResponseReplayer(nullptr);
+
+    // live slices are recorded with their month
+    std::remove(path.c_str());
+    StandinServer server;
+    server.start();
+    {
+        ResponseRecorder recorder(path);
+        setResponseRecorder(&recorder);
+        const std::vector<data> live = loader.load("IBM", {"2026-01"}, responseSliceFetch([&server](const std::string& symbol, const std::string& month) {
+            return fetchIntradayMonth(symbol, month, server.url());
+        }));
+        setResponseRecorder(nullptr);
+        // the stand-in slices by month: all of January 2026 and nothing outside it
+        ASSERT_EQ(live.size(), 31 * 288u);
+        EXPECT_EQ(live.front().time, parseTimestamp("2026-01-01 00:00:00"));
+        EXPECT_EQ(live.back().time, parseTimestamp("2026-01-31 23:55:00"));
+        EXPECT_TRUE(std::all_of(live.begin(), live.end(), [](const data& bar) {
+            return formatTimestamp(bar.time).starts_with("2026-01");
+        }));
+    }
+    EXPECT_NE(server.render("function=TIME_SERIES_INTRADAY&symbol=IBM&interval=5min&month=2026-13").find("Error Message"), std::string::npos);
+    server.stop();
+    ResponseReplayer recorded(path);
+    ASSERT_EQ(recorded.size(), 1u);
+    EXPECT_EQ(recorded.next()->month, "2026-01");
+
+    // transport failures are not handed on as bodies
+    EXPECT_THROW(loader.load("IBM", {"2026-01"}, responseSliceFetch([](const std::string& symbol, const std::string& month) {
+        return fetchIntradayMonth(symbol, month, "http://127.0.0.1:9/query");
+    })), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(BarColumns, SplitsAndReassemblesBars) {
+    const timestamp t0 = parseTimestamp("2025-05-12 19:30:00");
+    std::vector<data> bars;
+    for (int i = 0; i < 20; ++i) {
+        bars.emplace_back(t0 + i * barInterval, 100 + i, 101 + i, 102 + i, 99 + i, 1000 * i);
+    }
+    const BarColumns columns(bars.data(), bars.size());
+    ASSERT_EQ(columns.size(), 20u);
+    EXPECT_EQ(columns.closes()[3], 104);
+    EXPECT_EQ(columns.column(barColumn::volume)[5], 5000);
+    EXPECT_THROW(columns.column(barColumn::time), std::runtime_error);
+    for (std::span<const double> column : {columns.opens(), columns.highs(), columns.lows(), columns.closes(), columns.volumes()}) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(column.data()) % 64, 0u);
+    }
+
+    std::vector<data> back(columns.size());
+    columns.toBars(back.data());
+    EXPECT_EQ(back[7].time, bars[7].time);
+    EXPECT_EQ(back[7].high, bars[7].high);
+
+    const std::string path = ::testing::TempDir() + "columns.bars";
+    writeBarStore(path, "IBM", barInterval, bars.data(), bars.size());
+    const BarColumns fromStore{BarStore(path)};
+    EXPECT_EQ(fromStore.times()[19], bars[19].time);
+    EXPECT_EQ(fromStore.bar(19).low, bars[19].low);
+    std::remove(path.c_str());
+}
+
+TEST(ExactMovingAvg, SumsStayExactOverLongRuns) {
+    rawBar raw{"2025-05-12 19:30:00", "253.5000", "253.6753", "253.5", "253.6753", "12345678901"};
+    const fixedBar parsed = parseFixedBar(raw);
+    EXPECT_EQ(parsed.open, 2535000);
+    EXPECT_EQ(parsed.high, 2536753);
+    EXPECT_EQ(parsed.volume, 12345678901u);
+    EXPECT_EQ(parsed.toData().high, 253.6753);
+    EXPECT_EQ(fixedBar::fromData(parsed.toData()).close, parsed.close);
+    raw.open = "1.23456";
+    EXPECT_THROW(parseFixedBar(raw), std::runtime_error);
+
+    // a million updates leave the window sums equal to a recomputation from scratch
+    ExactMovingAvg engine(7);
+    std::vector<fixedBar> bars;
+    for (std::int64_t i = 0; i < 1000000; ++i) {
+        const std::int64_t price = 1000000 + (i * 7919) % 99991;
+        bars.emplace_back(i * barInterval, price, price + 1, price + 3, price - 3, 4000000000u + i);
+        engine.add(bars.back());
+    }
+    EXPECT_EQ(engine.count(), 7);
+    std::int64_t close = 0;
+    std::uint64_t volume = 0;
+    for (std::size_t i = bars.size() - 7; i < bars.size(); ++i) {
+        close += bars[i].close;
+        volume += bars[i].volume;
+    }
+    EXPECT_EQ(engine.sums().close, close);
+    EXPECT_EQ(engine.sums().volume, volume);
+    EXPECT_EQ(engine.closeSMA(), static_cast<double>(close) / (7.0 * priceScale));
+    EXPECT_THROW(ExactMovingAvg(3).closeSMA(), std::runtime_error);
+
+    // volumes beyond the range of int no longer overflow the floating point engine
+    MovingAvg floating(2);
+    floating.add(data(1, 1, 1, 1, 3000000000.0));
+    EXPECT_EQ(floating.volumeSMA(), 3000000000.0);
+}
+
+TEST(StaticMovingAvg, MatchesARecomputedWindow) {
+    StaticMovingAvg<6> engine;
+    StaticMovingAvg<6, smaClose> closeOnly;
+    std::vector<data> bars;
+    EXPECT_THROW(engine.closeSMA(), std::runtime_error);
+    for (int i = 0; i < 40; ++i) {
+        bars.emplace_back(i * barInterval, 100 + i % 7, 101 + i % 5, 103 + i % 3, 98 + i % 4, 1000 + 10 * i);
+        engine.add(bars.back());
+        closeOnly.add(bars.back());
+
+        const std::size_t n = std::min<std::size_t>(bars.size(), 6);
+        double close = 0, volume = 0;
+        for (std::size_t j = bars.size() - n; j < bars.size(); ++j) {
+            close += bars[j].close;
+            volume += bars[j].volume;
+        }
+        EXPECT_EQ(engine.size(), n);
+        EXPECT_NEAR(engine.closeSMA(), close / n, 1e-12);
+        EXPECT_NEAR(engine.volumeSMA(), volume / n, 1e-9);
+        EXPECT_EQ(closeOnly.closeSMA(), engine.closeSMA());
+    }
+    // untracked fields take no room
+    EXPECT_LT(sizeof(closeOnly), sizeof(engine) / 4);
+}
+
+TEST(RollingWindow, AggregatesProjectionsOverOneRing) {
+    RollingWindow<rolling<typicalPrice, rollingMean>, rolling<dollarVolume, rollingSum>,
+                  rolling<logReturn, rollingVariance>> window(5);
+    std::vector<data> bars;
+    for (int i = 0; i < 30; ++i) {
+        const double close = 100 + 3 * std::sin(i * 0.7);
+        bars.emplace_back(i * barInterval, close - 0.5, close, close + 1, close - 1, 1000 + 50 * (i % 4));
+        window.add(bars.back());
+
+        const std::size_t n = std::min<std::size_t>(bars.size(), 5);
+        double typical = 0, dollars = 0;
+        std::vector<double> returns;
+        for (std::size_t j = bars.size() - n; j < bars.size(); ++j) {
+            typical += (bars[j].high + bars[j].low + bars[j].close) / 3;
+            dollars += bars[j].close * bars[j].volume;
+            if (j > 0) returns.push_back(std::log(bars[j].close / bars[j - 1].close));
+        }
+        EXPECT_EQ(window.size(), static_cast<int>(n));
+        EXPECT_NEAR(window.value<0>(), typical / n, 1e-9);
+        EXPECT_NEAR(window.value<1>(), dollars, 1e-6);
+        ASSERT_EQ(window.aggregate<2>().kind.count, returns.size());
+        if (returns.empty()) {
+            EXPECT_THROW(window.value<2>(), std::runtime_error);
+            continue;
+        }
+        double mean = 0, m2 = 0;
+        for (double r : returns) mean += r / returns.size();
+        for (double r : returns) m2 += (r - mean) * (r - mean);
+        EXPECT_NEAR(window.value<2>(), m2 / returns.size(), 1e-12);
+    }
+}
+
+TEST(CircularDeque, WrapsUnderBothIndexPolicies) {
+    circularDeque<int> modulo(5);
+    circularDeque<int, true> masked(5);
+    EXPECT_EQ(modulo.capacity(), 5u);
+    EXPECT_EQ(masked.capacity(), 8u);
+    EXPECT_THROW(circularDeque<int>(0), std::invalid_argument);
+
+    // the window slides backwards past the starting counter, then forwards past it again
+    for (int i = 0; i < 100; ++i) {
+        modulo.insertFront(-i);
+        masked.insertFront(-i);
+        if (modulo.size() == 4) modulo.popBack();
+        if (masked.size() == 4) masked.popBack();
+        EXPECT_EQ(modulo.getFront(), -i);
+        EXPECT_EQ(masked.getFront(), -i);
+    }
+    EXPECT_EQ(modulo.getBack(), -97);
+    EXPECT_EQ(masked.getBack(), -97);
+    for (int i = 0; i < 300; ++i) {
+        modulo.insertBack(i);
+        masked.insertBack(i);
+        modulo.popFront();
+        masked.popFront();
+        EXPECT_EQ(modulo.getBack(), i);
+        EXPECT_EQ(masked.getBack(), i);
+    }
+    EXPECT_EQ(modulo.size(), 3u);
+    EXPECT_EQ(masked.getFront(), 297);
+
+    circularDeque<int> full(2);
+    full.insertBack(1);
+    full.insertBack(2);
+    full.insertBack(3); // ignored while full
+    EXPECT_EQ(full.getBack(), 2);
+    full.popFront();
+    full.popFront();
+    EXPECT_TRUE(full.isEmpty());
+    EXPECT_THROW(full.popFront(), std::runtime_error);
+
+    circularDeque<int> ring(3);
+    int evicted = -1;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FALSE(ring.pushEvict(i, evicted));
+    }
+    for (int i = 3; i < 10; ++i) {
+        EXPECT_TRUE(ring.pushEvict(i, evicted));
+        EXPECT_EQ(evicted, i - 3);
+        EXPECT_EQ(ring.getFront(), i - 2);
+        EXPECT_EQ(ring.getBack(), i);
+        EXPECT_EQ(ring.size(), 3u);
+    }
+}
+
+TEST(CircularDeque, IteratesAndSplitsIntoSpans) {
+    static_assert(std::random_access_iterator<circularDeque<data>::iterator>);
+    static_assert(std::random_access_iterator<circularDeque<data>::const_iterator>);
+
+    circularDeque<int> ring(5);
+    int evicted;
+    for (int i = 0; i < 8; ++i) {
+        ring.pushEvict(i * 10, evicted);
+    }
+    // holds 30 40 50 60 70, wrapped after 40
+    EXPECT_EQ(ring[0], 30);
+    EXPECT_EQ(ring[4], 70);
+    EXPECT_EQ(ring.end() - ring.begin(), 5);
+    EXPECT_EQ(*std::max_element(ring.begin(), ring.end()), 70);
+    EXPECT_EQ(std::vector<int>(ring.begin(), ring.end()), (std::vector<int>{30, 40, 50, 60, 70}));
+    EXPECT_EQ(*(ring.end() - 2), 60);
+    ring[1] = 41;
+    *ring.begin() += 1;
+    EXPECT_EQ(&ring.getFront(), &ring[0]);
+
+    const auto [first, second] = ring.as_spans();
+    EXPECT_EQ(std::vector<int>(first.begin(), first.end()), (std::vector<int>{31, 41}));
+    EXPECT_EQ(std::vector<int>(second.begin(), second.end()), (std::vector<int>{50, 60, 70}));
+
+    const circularDeque<int>& view = ring;
+    circularDeque<int>::const_iterator it = ring.begin();
+    EXPECT_EQ(it, view.begin());
+    EXPECT_EQ(std::accumulate(view.begin(), view.end(), 0), 31 + 41 + 50 + 60 + 70);
+
+    circularDeque<int> unwrapped(4);
+    unwrapped.insertBack(1);
+    unwrapped.insertBack(2);
+    EXPECT_EQ(unwrapped.as_spans().first.size(), 2u);
+    EXPECT_TRUE(unwrapped.as_spans().second.empty());
+}
+
+TEST(CircularDeque, GrowsAndShrinksKeepingOrder) {
+    circularDeque<int> growing(3, dequeGrowth::doubling);
+    growing.insertBack(1);
+    growing.insertBack(2);
+    growing.popFront();
+    growing.insertBack(3);
+    growing.insertBack(4); // wraps
+    growing.insertBack(5); // full: doubles to 6 and linearizes
+    growing.insertFront(0);
+    EXPECT_EQ(growing.capacity(), 6u);
+    EXPECT_EQ(std::vector<int>(growing.begin(), growing.end()), (std::vector<int>{0, 2, 3, 4, 5}));
+    for (int i = 6; i < 40; ++i) {
+        growing.insertBack(i);
+    }
+    EXPECT_EQ(growing.size(), 39u);
+    EXPECT_EQ(growing.capacity(), 48u);
+    EXPECT_EQ(growing[38], 39);
+
+    while (growing.size() > 5) growing.popFront();
+    growing.shrink_to_fit();
+    EXPECT_EQ(growing.capacity(), 5u);
+    EXPECT_EQ(std::vector<int>(growing.begin(), growing.end()), (std::vector<int>{35, 36, 37, 38, 39}));
+
+    // reserve works under the fixed policy too; the mask policy keeps a power of two
+    circularDeque<int, true> masked(4);
+    for (int i = 0; i < 4; ++i) masked.insertBack(i);
+    masked.insertBack(4); // dropped
+    masked.reserve(5);
+    masked.insertBack(4);
+    EXPECT_EQ(masked.capacity(), 8u);
+    EXPECT_EQ(masked.getBack(), 4);
+    masked.reserve(2);
+    EXPECT_EQ(masked.capacity(), 8u);
+    masked.shrink_to_fit();
+    EXPECT_EQ(masked.capacity(), 8u);
+    EXPECT_EQ(masked.getFront(), 0);
+}
+
+#ifdef __linux__
+TEST(CircularDeque, MirroredStorageKeepsTheWindowContiguous) {
+    circularDeque<data, true, mirroredStorage<data>> ring(100);
+    EXPECT_GE(ring.capacity(), 128u);
+    EXPECT_EQ(ring.capacity() * sizeof(data) % static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)), 0u);
+    EXPECT_THROW((circularDeque<data, false, mirroredStorage<data>>(0)), std::invalid_argument);
+
+    data evicted;
+    const std::size_t total = ring.capacity() + ring.capacity() / 2 + 3;
+    for (std::size_t i = 0; i < total; ++i) {
+        ring.pushEvict(data(static_cast<timestamp>(i), 1, static_cast<double>(i), 1, 1, 1), evicted);
+    }
+    // the window wraps in the array but not in the span
+    const std::span<const data> window = std::as_const(ring).window();
+    ASSERT_EQ(window.size(), ring.capacity());
+    for (std::size_t i = 0; i < window.size(); ++i) {
+        ASSERT_EQ(window[i].time, static_cast<timestamp>(total - ring.capacity() + i));
+    }
+    EXPECT_EQ(ring.as_spans().first.size(), ring.size());
+    EXPECT_TRUE(ring.as_spans().second.empty());
+
+    // the tail of the span is the second mapping of the array's first pages
+    ring.window().back().close = -1;
+    EXPECT_EQ(ring.getBack().close, -1);
+    EXPECT_NE(&window.back(), &ring.getBack());
+
+    const data newest = ring.getBack();
+    ring.reserve(ring.capacity() + 1);
+    EXPECT_EQ(ring.window().back().time, newest.time);
+    EXPECT_EQ(ring.window().front().time, static_cast<timestamp>(total - ring.size()));
+}
+#endif
+
+TEST(MovingAvg, WindowKeepsAdvancingOnceFull) {
+    MovingAvg engine(3);
+    for (int i = 1; i <= 10; ++i) {
+        engine.add(data(i, i, i, i, 100 * i));
+    }
+    // the last three bars are 8, 9 and 10
+    EXPECT_DOUBLE_EQ(engine.closeSMA(), 9);
+    EXPECT_DOUBLE_EQ(engine.volumeSMA(), 900);
+}
+
+TEST(SpscRing, HandsBarsAcrossThreadsInOrder) {
+    SpscRing<data> ring(100);
+    EXPECT_EQ(ring.capacity(), 128u);
+    data out;
+    EXPECT_FALSE(ring.tryPop(out));
+
+    constexpr int total = 1000000;
+    std::thread producer([&ring] {
+        data batch[16];
+        for (int i = 0; i < total;) {
+            if (i % 3 == 0) {
+                if (ring.tryPush(data(i, i, i, i, i, i))) ++i;
+                else std::this_thread::yield();
+                continue;
+            }
+            int n = 0;
+            for (; n < 16 && i + n < total; ++n) {
+                batch[n] = data(i + n, i + n, i + n, i + n, i + n, i + n);
+            }
+            const std::size_t pushed = ring.pushBatch(batch, static_cast<std::size_t>(n));
+            if (pushed == 0) std::this_thread::yield();
+            i += static_cast<int>(pushed);
+        }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    data batch[32];
+    while (expected < total) {
+        if (expected % 2 == 0 && ring.tryPop(out)) {
+            ordered &= out.time == expected && out.close == expected;
+            ++expected;
+            continue;
+        }
+        const std::size_t n = ring.popBatch(batch, 32);
+        if (n == 0) std::this_thread::yield();
+        for (std::size_t i = 0; i < n; ++i) {
+            ordered &= batch[i].time == expected++;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST(MpmcQueue, DeliversEveryElementExactlyOnce) {
+    MpmcQueue<data> queue(64);
+    EXPECT_EQ(queue.capacity(), 64u);
+    data out;
+    EXPECT_FALSE(queue.try_pop(out));
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_TRUE(queue.try_push(data(i, i, i, i, i, i)));
+    }
+    EXPECT_FALSE(queue.try_push(data()));
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_TRUE(queue.try_pop(out));
+        EXPECT_EQ(out.time, i);
+    }
+
+    // three producers fan in to two consumers; each bar must arrive once
+    constexpr int perProducer = 100000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 3; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < perProducer; ++i) {
+                queue.push(data(p * perProducer + i, 1, 1, 1, 1, 1));
+            }
+        });
+    }
+    std::vector<std::vector<timestamp>> seen(2);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c) {
+        consumers.emplace_back([&queue, &seen, c] {
+            data bar;
+            for (int i = 0; i < 3 * perProducer / 2; ++i) {
+                queue.pop(bar);
+                seen[c].push_back(bar.time);
+            }
+        });
+    }
+    for (std::thread& t : producers) t.join();
+    for (std::thread& t : consumers) t.join();
+
+    std::vector<timestamp> all(seen[0]);
+    all.insert(all.end(), seen[1].begin(), seen[1].end());
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), 3u * perProducer);
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        ASSERT_EQ(all[i], static_cast<timestamp>(i));
+    }
+    // each consumer sees any one producer's bars in order
+    for (const std::vector<timestamp>& s : seen) {
+        timestamp last[3] = {-1, -1, -1};
+        for (timestamp t : s) {
+            EXPECT_GT(t, last[t / perProducer]);
+            last[t / perProducer] = t;
+        }
+    }
+    EXPECT_EQ(queue.size(), 0u);
+}
@@ -5,9 +5,27 @@
 #ifndef CIRCULARDEQUE_H
 #define CIRCULARDEQUE_H
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "ringStorage.h"
 
-template <typename T>
+/**
+ * What a circularDeque does when an insert finds it full.
+ */
+enum class dequeGrowth {
+    fixed,   // drop the new element
+    doubling // double the capacity, linearizing the elements into the new array
+};
+
+template <typename T, bool PowerOfTwo = false, typename Storage = heapStorage<T>>
 /**
  * @class circularDeque
  * @brief A data structure representing a circular double-ended queue (deque).
@@ -19,6 +37,21 @@ template <typename T>
  *
  * This data structure is useful in scenarios where a fixed-size queue is required,
  * and where operations at both ends are frequent and must be efficient.
+ *
+ * Positions are tracked with two monotonically increasing 64-bit counters, head and tail,
+ * whose difference is the size; a counter becomes a slot index only on access. With
+ * PowerOfTwo set, the capacity is rounded up to a power of two and that mapping is a bit
+ * mask; otherwise it is a modulo by the exact requested capacity.
+ *
+ * With mirroredStorage (Linux) the array is mapped twice back to back, so the live window is
+ * always one contiguous run and window() can hand it out as a single span.
+ *
+ * A deque constructed with dequeGrowth::doubling grows instead of dropping inserts once
+ * full; reserve and shrink_to_fit resize it explicitly under either policy.
+ *
+ * @tparam T The element type.
+ * @tparam PowerOfTwo Round the capacity up to a power of two and index with a mask.
+ * @tparam Storage Owner of the element array: heapStorage<T> or mirroredStorage<T>.
  */
 class circularDeque {
     /**
@@ -29,45 +62,55 @@ class circularDeque {
      * enabling efficient insert and removal operations at both the front and back of the deque.
      *
      * @note The size of the array is determined by the `capacity` variable.
-     *       Memory for this array is allocated in the constructor and released in the destructor.
+     *       The array is owned by `storage`, which releases it in its destructor.
      */
 private:
+    Storage storage;
     T* array;
     /**
-     * @brief Retrieves the maximum number of elements that a container can hold.
-     *
-     * This function provides information about the storage capacity of a container.
-     * The capacity depends on the implementation and may vary for different types
-     * of containers or different instances of the same container type.
-     *
-     * @return size_t The maximum number of elements the container can hold
-     *                before needing to reallocate memory.
+     * @brief The number of slots in `array`, i.e. the maximum number of elements.
      */
-    int capacity;
+    std::size_t slots;
     /**
-     * @brief Represents the front element in a data structure, such as a queue or deque.
-     *
-     * The `front` variable is used to access or reference the first element
-     * of the data structure without removing it. Its exact definition and
-     * functionality can vary depending on the context and the type of
-     * data structure implemented.
+     * @brief slots - 1; only meaningful when PowerOfTwo is set.
+     */
+    std::size_t mask;
+    /**
+     * @brief Counter of the front element and one past the back element.
      *
-     * Typical use cases for this variable include retrieving the first
-     * element for processing in FIFO (First-In-First-Out) data structures
-     * or as a reference in iterators.
+     * Both only move by one per insert or pop and never wrap in practice. They start at a
+     * multiple of the capacity in the middle of the range, so insertFront can step head
+     * below its start without underflow, and the starting counter maps to slot 0.
+     */
+    std::uint64_t head;
+    std::uint64_t tail;
+    /**
+     * @brief What insertFront and insertBack do when the deque is full.
      */
-    int front;
+    dequeGrowth growth;
 
     /**
-     * Represents the current number of elements in the circular deque.
-     *
-     * This variable tracks how many elements are currently stored in the
-     * circular deque. It is incremented when an element is successfully
-     * added to the deque and decremented when an element is removed.
+     * Moves the elements, front first, into fresh storage of at least `requested` slots.
      */
-public:
-    int size;
+    void reallocate(std::size_t requested);
+
+    static std::size_t checkedCapacity(std::size_t capacity) {
+        if (capacity == 0) throw std::invalid_argument("Deque capacity must be positive");
+        return capacity;
+    }
 
+    /**
+     * Maps a counter to its slot in `array`.
+     */
+    std::size_t slot(std::uint64_t counter) const {
+        if constexpr (PowerOfTwo) {
+            return static_cast<std::size_t>(counter) & mask;
+        } else {
+            return static_cast<std::size_t>(counter % slots);
+        }
+    }
+
+public:
     /**
      * @class CircularDeque
      *
@@ -79,7 +122,10 @@ public:
      *
      * @tparam T The type of elements stored in the deque.
      */
-    circularDeque(int capacity);
+    explicit circularDeque(std::size_t capacity, dequeGrowth growth = dequeGrowth::fixed);
+
+    circularDeque(const circularDeque&) = delete;
+    circularDeque& operator=(const circularDeque&) = delete;
 
     /**
      * @brief Reverses the given string in place.
@@ -105,6 +151,16 @@ public:
      */
     bool isEmpty() const;
 
+    /**
+     * @return The number of elements in the deque.
+     */
+    std::size_t size() const { return static_cast<std::size_t>(tail - head); }
+
+    /**
+     * @return The maximum number of elements; rounded up to a power of two with PowerOfTwo.
+     */
+    std::size_t capacity() const { return slots; }
+
     /**
      * Inserts an element at the front of the circular deque.
      *
@@ -114,12 +170,38 @@ public:
 
     /**
      * Inserts an element at the back of the circular deque.
-     * If the deque is at maximum capacity, the operation is ignored.
+     * If the deque is at maximum capacity, the operation is ignored unless the deque
+     * was constructed with dequeGrowth::doubling, in which case the capacity doubles.
      *
      * @param value The element of type T to be inserted at the back of the deque.
      */
     void insertBack(T value);
 
+    /**
+     * Inserts an element at the back of the circular deque, overwriting the front element
+     * in place if the deque is full. The window keeps advancing once full instead of
+     * dropping new values.
+     *
+     * @param value The element to insert.
+     * @param evicted Receives the overwritten front element if the deque was full.
+     * @return true if an element was evicted.
+     */
+    bool pushEvict(const T& value, T& evicted);
+
+    /**
+     * Grows the capacity to at least `capacity`, keeping the elements in order.
+     * Never shrinks.
+     *
+     * @param capacity The minimum capacity.
+     */
+    void reserve(std::size_t capacity);
+
+    /**
+     * Shrinks the capacity to the current size (at least one slot), or as close as the
+     * index policy and storage allow.
+     */
+    void shrink_to_fit();
+
     /**
      * Removes and returns the front element of a collection, if one exists.
      *
@@ -149,7 +231,7 @@ public:
      *
      * @return The front element of the collection.
      */
-    T getFront() const;
+    const T& getFront() const;
 
     /**
      * Retrieves the element from the back of the deque without removing it.
@@ -157,7 +239,7 @@ public:
      * @return The element at the back of the deque.
      * @throws std::runtime_error if the deque is empty.
      */
-    T getBack() const;
+    const T& getBack() const;
 
     /**
      * @brief Prints all elements of the circular deque in order from the front to the back.
@@ -173,21 +255,112 @@ public:
      * @note The method assumes the deque is non-empty. If used on an empty deque, results may be undefined.
      */
     void print() const;
+
+    /**
+     * @brief Random access iterator over the deque, front to back.
+     *
+     * Holds a counter rather than a slot, so stepping never wraps by hand; the slot is only
+     * computed on dereference. Invalidated by any insert or pop.
+     */
+    template <bool Const>
+    class basicIterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using owner = std::conditional_t<Const, const circularDeque*, circularDeque*>;
+
+        basicIterator() = default;
+        basicIterator(owner deque, std::uint64_t counter) : deque(deque), counter(counter) {}
+        operator basicIterator<true>() const requires (!Const) { return {deque, counter}; }
+
+        reference operator*() const { return deque->array[deque->slot(counter)]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        basicIterator& operator++() { ++counter; return *this; }
+        basicIterator operator++(int) { basicIterator old = *this; ++counter; return old; }
+        basicIterator& operator--() { --counter; return *this; }
+        basicIterator operator--(int) { basicIterator old = *this; --counter; return old; }
+        basicIterator& operator+=(difference_type n) { counter += n; return *this; }
+        basicIterator& operator-=(difference_type n) { counter -= n; return *this; }
+        friend basicIterator operator+(basicIterator it, difference_type n) { return it += n; }
+        friend basicIterator operator+(difference_type n, basicIterator it) { return it += n; }
+        friend basicIterator operator-(basicIterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const basicIterator& a, const basicIterator& b) {
+            return static_cast<difference_type>(a.counter - b.counter);
+        }
+
+        bool operator==(const basicIterator& other) const { return counter == other.counter; }
+        auto operator<=>(const basicIterator& other) const { return counter <=> other.counter; }
+
+    private:
+        owner deque = nullptr;
+        std::uint64_t counter = 0;
+    };
+
+    using iterator = basicIterator<false>;
+    using const_iterator = basicIterator<true>;
+
+    iterator begin() { return {this, head}; }
+    iterator end() { return {this, tail}; }
+    const_iterator begin() const { return {this, head}; }
+    const_iterator end() const { return {this, tail}; }
+
+    /**
+     * @param i The position from the front, 0 through size() - 1; not bounds checked.
+     * @return The element at that position.
+     */
+    T& operator[](std::size_t i) { return array[slot(head + i)]; }
+    const T& operator[](std::size_t i) const { return array[slot(head + i)]; }
+
+    /**
+     * Returns the elements as the (at most) two contiguous runs they occupy in the ring:
+     * front to the end of the array, then the start of the array to the back. Loops over
+     * the two spans need no index wrapping and vectorize like loops over a plain array.
+     *
+     * @return The first and second segment, in deque order; the second is empty unless
+     *         the elements wrap.
+     */
+    std::pair<std::span<const T>, std::span<const T>> as_spans() const {
+        if constexpr (Storage::mirrored) {
+            return {window(), std::span<const T>()};
+        }
+        const std::size_t first = slot(head);
+        const std::size_t n = size();
+        const std::size_t firstLength = n < slots - first ? n : slots - first;
+        return {std::span<const T>(array + first, firstLength), std::span<const T>(array, n - firstLength)};
+    }
+
+    /**
+     * Returns all elements, front to back, as one contiguous span; the second mapping
+     * absorbs the wrap. Only available with mirroredStorage.
+     *
+     * @return The live window.
+     */
+    std::span<T> window() requires Storage::mirrored { return {array + slot(head), size()}; }
+    std::span<const T> window() const requires Storage::mirrored { return {array + slot(head), size()}; }
 };
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * Creates a circular deque data structure that can perform operations
  * such as inserting, deleting, and accessing elements in a circular manner.
  *
  * @param capacity The maximum number of elements the circular deque can hold.
+ * @param growth Whether inserts into a full deque are dropped or double the capacity.
  * @return An instance of a circular deque with the specified capacity.
  */
-circularDeque<T>::circularDeque(int capacity) : size(0), front(0), capacity(capacity) {
-    array = new T[capacity]; // ✅ FIXED
+circularDeque<T, PowerOfTwo, Storage>::circularDeque(std::size_t capacity, dequeGrowth growth)
+    : storage(PowerOfTwo ? std::bit_ceil(checkedCapacity(capacity)) : checkedCapacity(capacity)),
+      array(storage.data()), slots(storage.size()), mask(slots - 1), growth(growth) {
+    head = tail = (UINT64_MAX / 2) / slots * slots;
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * @class MyClass
  * @brief A class that demonstrates a sample functionality.
@@ -195,11 +368,9 @@ template <typename T>
  * This class provides methods to perform basic operations
  * such as setting and retrieving a value.
  */
-circularDeque<T>::~circularDeque() {
-    delete[] array; // ✅ FIXED
-}
+circularDeque<T, PowerOfTwo, Storage>::~circularDeque() = default;
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * Checks if the object is empty. The definition of "empty" depends on the
  * specific object's implementation and context. For collections or strings,
@@ -207,38 +378,107 @@ template <typename T>
  *
  * @return true if the object is empty, false otherwise.
  */
-bool circularDeque<T>::isEmpty() const {
-    return size == 0;
+bool circularDeque<T, PowerOfTwo, Storage>::isEmpty() const {
+    return head == tail;
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * Inserts an element at the front of a collection, such as a linked list or deque.
  *
  * @param element The element to be added to the front of the collection.
  */
-void circularDeque<T>::insertFront(T value) {
-    if (size == capacity) return;
-    front = (front - 1 + capacity) % capacity;
-    array[front] = value;
-    size++;
+void circularDeque<T, PowerOfTwo, Storage>::insertFront(T value) {
+    if (size() == slots) {
+        if (growth == dequeGrowth::fixed) return;
+        reallocate(slots * 2);
+    }
+    array[slot(--head)] = value;
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * Inserts the given value at the back of the circular deque.
- * If the deque is already full (size == capacity), the operation will not be performed.
+ * If the deque is already full (size() == capacity()), the operation will not be performed,
+ * unless the growth policy is dequeGrowth::doubling.
  *
  * @param value The value to be inserted at the back of the deque.
  */
-void circularDeque<T>::insertBack(T value) {
-    if (size == capacity) return;
-    int back = (front + size) % capacity;
-    array[back] = value;
-    size++;
+void circularDeque<T, PowerOfTwo, Storage>::insertBack(T value) {
+    if (size() == slots) {
+        if (growth == dequeGrowth::fixed) return;
+        reallocate(slots * 2);
+    }
+    array[slot(tail++)] = value;
+}
+
+template <typename T, bool PowerOfTwo, typename Storage>
+/**
+ * Inserts at the back, evicting the front element when full. A full deque's back slot is
+ * its front slot, so eviction is one slot computation, a move out and a store. Never grows,
+ * whatever the growth policy: the capacity is the window length.
+ *
+ * @param value The element to insert.
+ * @param evicted Receives the evicted element, if any.
+ * @return true if an element was evicted.
+ */
+bool circularDeque<T, PowerOfTwo, Storage>::pushEvict(const T& value, T& evicted) {
+    T& cell = array[slot(tail++)];
+    if (tail - head > slots) {
+        head++;
+        evicted = std::move(cell);
+        cell = value;
+        return true;
+    }
+    cell = value;
+    return false;
+}
+
+template <typename T, bool PowerOfTwo, typename Storage>
+/**
+ * Grows the deque so it can hold at least `capacity` elements.
+ *
+ * @param capacity The minimum capacity.
+ */
+void circularDeque<T, PowerOfTwo, Storage>::reserve(std::size_t capacity) {
+    if (capacity > slots) reallocate(capacity);
+}
+
+template <typename T, bool PowerOfTwo, typename Storage>
+/**
+ * Releases the unused slots of the deque.
+ */
+void circularDeque<T, PowerOfTwo, Storage>::shrink_to_fit() {
+    const std::size_t wanted = size() > 0 ? size() : 1;
+    const std::size_t rounded = PowerOfTwo ? std::bit_ceil(wanted) : wanted;
+    if (rounded < slots) reallocate(wanted);
+}
+
+template <typename T, bool PowerOfTwo, typename Storage>
+/**
+ * Moves the elements into new storage. The ring is read as its (at most) two contiguous
+ * segments, so the copy is two bulk moves (memmove for trivially copyable T) and the
+ * elements start at slot 0 of the new array.
+ *
+ * @param requested The minimum number of slots of the new storage.
+ */
+void circularDeque<T, PowerOfTwo, Storage>::reallocate(std::size_t requested) {
+    Storage replacement(PowerOfTwo ? std::bit_ceil(requested) : requested);
+    const std::size_t n = size();
+    const std::size_t first = slot(head);
+    const std::size_t firstLength = std::min(n, slots - first);
+    T* out = std::move(array + first, array + first + firstLength, replacement.data());
+    std::move(array, array + (n - firstLength), out);
+
+    storage.swap(replacement);
+    array = storage.data();
+    slots = storage.size();
+    mask = slots - 1;
+    head = (UINT64_MAX / 2) / slots * slots;
+    tail = head + n;
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * @brief Removes the element at the front of the deque.
  *
@@ -248,13 +488,12 @@ template <typename T>
  *
  * @throws std::runtime_error if the deque is empty.
  */
-void circularDeque<T>::popFront() {
+void circularDeque<T, PowerOfTwo, Storage>::popFront() {
     if (isEmpty()) throw std::runtime_error("Deque is empty");
-    front = (front + 1) % capacity;
-    size--;
+    head++;
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * @brief Removes the last element from the container.
  *
@@ -267,23 +506,23 @@ template <typename T>
  * @note The method invalidates any references, pointers, or iterators pointing
  *       to the last element of the container.
  */
-void circularDeque<T>::popBack() {
+void circularDeque<T, PowerOfTwo, Storage>::popBack() {
     if (isEmpty()) throw std::runtime_error("Deque is empty");
-    size--;
+    tail--;
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * Retrieves the front element of a collection or data structure without removing it.
  *
  * @return The front element of the collection or data structure.
  */
-T circularDeque<T>::getFront() const {
+const T& circularDeque<T, PowerOfTwo, Storage>::getFront() const {
     if (isEmpty()) throw std::runtime_error("Deque is empty");
-    return array[front];
+    return array[slot(head)];
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * Retrieves a reference or copy to the last element in a container or data structure.
  *
@@ -293,12 +532,12 @@ template <typename T>
  *
  * @return The last element of the container or data structure.
  */
-T circularDeque<T>::getBack() const {
+const T& circularDeque<T, PowerOfTwo, Storage>::getBack() const {
     if (isEmpty()) throw std::runtime_error("Deque is empty");
-    return array[(front + size - 1 + capacity) % capacity];
+    return array[slot(tail - 1)];
 }
 
-template <typename T>
+template <typename T, bool PowerOfTwo, typename Storage>
 /**
  * Prints the specified message to the standard output stream.
  *
@@ -309,9 +548,9 @@ template <typename T>
  * @param message The string to be printed. Should not be null.
  *                A valid string must be provided.
  */
-void circularDeque<T>::print() const {
-    for (int i = 0; i < size; ++i) {
-        std::cout << array[(front + i) % capacity] << ' ';
+void circularDeque<T, PowerOfTwo, Storage>::print() const {
+    for (std::uint64_t i = head; i != tail; ++i) {
+        std::cout << array[slot(i)] << ' ';
     }
     std::cout << '\n';
 }
@@ -5,10 +5,13 @@
 #ifndef DATA_H
 #define DATA_H
 #include <ostream>
+#include "timestamp.h"
 struct data {
+    timestamp time;
     double open, close, high, low, volume;
-    data() : open(0), close(0), high(0), low(0), volume(0) {}
-    data(double open, double close, double high, double low, double volume) : open(open), close(close), high(high), low(low), volume(volume) {};
+    data() : time(0), open(0), close(0), high(0), low(0), volume(0) {}
+    data(double open, double close, double high, double low, double volume) : time(0), open(open), close(close), high(high), low(low), volume(volume) {};
+    data(timestamp time, double open, double close, double high, double low, double volume) : time(time), open(open), close(close), high(high), low(low), volume(volume) {};
 };
 
 inline std::ostream& operator<<(std::ostream& os, const data& d) {
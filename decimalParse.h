@@ -0,0 +1,190 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef DECIMALPARSE_H
+#define DECIMALPARSE_H
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * Fixed-format parsers for the numeric fields of a bar.
+ *
+ * Alpha Vantage always sends prices as "ddd.dddd" and volumes as plain integers. Both are
+ * parsed eight digits at a time with SWAR (SIMD within a register) arithmetic on a single
+ * 64-bit word, straight out of a string view. Anything that does not fit the fixed format
+ * (signs, exponents, more than four decimals, very long integers) falls back to
+ * std::from_chars, so the parsers accept every number the feed could legally contain.
+ */
+
+/**
+ * Loads up to eight ASCII characters into a word, right aligned and left padded with '0'.
+ *
+ * @param p The first character.
+ * @param n The number of characters to load, at most 8.
+ * @return The characters as a little-endian word, first character in the lowest byte.
+ */
+inline std::uint64_t loadDigits8(const char* p, std::size_t n) {
+    char buffer[8] = {'0', '0', '0', '0', '0', '0', '0', '0'};
+    std::memcpy(buffer + 8 - n, p, n);
+    std::uint64_t word;
+    std::memcpy(&word, buffer, 8);
+    return word;
+}
+
+/**
+ * @param word Eight characters loaded by loadDigits8.
+ * @return true if every byte of the word is an ASCII digit.
+ */
+inline bool isEightDigits(std::uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+/**
+ * Converts eight ASCII digits to their value in three multiply steps instead of eight.
+ *
+ * @param word Eight digits loaded by loadDigits8.
+ * @return The value of the digits, 0 through 99999999.
+ */
+inline std::uint32_t parseEightDigits(std::uint64_t word) {
+    if constexpr (std::endian::native == std::endian::little) {
+        word -= 0x3030303030303030ULL;
+        word = (word * 10) + (word >> 8);
+        word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        return static_cast<std::uint32_t>(word);
+    } else {
+        char digits[8];
+        std::memcpy(digits, &word, 8);
+        std::uint32_t value = 0;
+        for (char c : digits) value = value * 10 + static_cast<std::uint32_t>(c - '0');
+        return value;
+    }
+}
+
+/**
+ * Parses up to eight digits.
+ *
+ * @param text The digits.
+ * @param value Receives the value.
+ * @return false if the text is empty, longer than eight characters or not all digits.
+ */
+inline bool parseDigits8(std::string_view text, std::uint32_t& value) {
+    if (text.empty() || text.size() > 8) return false;
+    const std::uint64_t word = loadDigits8(text.data(), text.size());
+    if (!isEightDigits(word)) return false;
+    value = parseEightDigits(word);
+    return true;
+}
+
+/**
+ * Parses a "ddd.dddd" price as an integer count of ten-thousandths, without any rounding.
+ *
+ * @param text The price.
+ * @param value Receives the price times 10000.
+ * @return false if the text does not fit the fixed format: up to eight integer digits and
+ *         up to four decimals, no sign or exponent.
+ */
+inline bool parseFixed4(std::string_view text, std::int64_t& value) {
+    static constexpr std::uint32_t scale[5] = {10000, 1000, 100, 10, 1};
+    const std::size_t dot = text.find('.');
+    std::uint32_t whole = 0;
+    std::uint32_t fraction = 0;
+    if (dot == std::string_view::npos) {
+        if (!parseDigits8(text, whole)) return false;
+    } else {
+        const std::size_t decimals = text.size() - dot - 1;
+        if (decimals > 4 || !parseDigits8(text.substr(0, dot), whole)) return false;
+        if (decimals > 0 && !parseDigits8(text.substr(dot + 1), fraction)) return false;
+        fraction *= scale[decimals];
+    }
+    value = static_cast<std::int64_t>(whole) * 10000 + fraction;
+    return true;
+}
+
+/**
+ * General fallback for fields that do not fit the fixed format.
+ *
+ * std::from_chars also accepts "nan" and "inf", which are not prices or volumes and would
+ * poison every average they reach, so non-finite results are rejected like any other
+ * malformed field.
+ *
+ * @param text The field.
+ * @return The value of the field.
+ * @throws std::runtime_error if the text is not a finite number.
+ */
+inline double parseFiniteDouble(std::string_view text) {
+    double value = 0;
+    const char* last = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), last, value);
+    if (ec != std::errc() || ptr != last || !std::isfinite(value)) {
+        throw std::runtime_error("Malformed bar field");
+    }
+    return value;
+}
+
+/**
+ * Parses a price field.
+ *
+ * The fixed-format fast path divides the exact ten-thousandths count by 10000, which yields
+ * the same correctly rounded double as a general decimal parser would.
+ *
+ * @param text The price.
+ * @return The price.
+ * @throws std::runtime_error if the text is not a finite number.
+ */
+inline double parsePrice(std::string_view text) {
+    std::int64_t fixed;
+    if (parseFixed4(text, fixed)) {
+        return static_cast<double>(fixed) / 10000.0;
+    }
+    return parseFiniteDouble(text);
+}
+
+/**
+ * Parses a volume field as an integer of up to sixteen digits with the fast path.
+ *
+ * @param text The volume.
+ * @param value Receives the volume.
+ * @return false if the text is empty, longer than sixteen characters or not all digits.
+ */
+inline bool parseVolumeDigits(std::string_view text, std::uint64_t& value) {
+    if (text.size() <= 8) {
+        std::uint32_t low;
+        if (!parseDigits8(text, low)) return false;
+        value = low;
+        return true;
+    }
+    std::uint32_t high, low;
+    if (text.size() > 16 ||
+        !parseDigits8(text.substr(0, text.size() - 8), high) ||
+        !parseDigits8(text.substr(text.size() - 8), low)) {
+        return false;
+    }
+    value = static_cast<std::uint64_t>(high) * 100000000ULL + low;
+    return true;
+}
+
+/**
+ * Parses a volume field.
+ *
+ * @param text The volume.
+ * @return The volume.
+ * @throws std::runtime_error if the text is not a finite number.
+ */
+inline double parseVolume(std::string_view text) {
+    std::uint64_t digits;
+    if (parseVolumeDigits(text, digits)) {
+        return static_cast<double>(digits);
+    }
+    return parseFiniteDouble(text);
+}
+
+#endif //DECIMALPARSE_H
@@ -0,0 +1,55 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef FIXEDBAR_H
+#define FIXEDBAR_H
+
+#include <cmath>
+#include <cstdint>
+#include "data.h"
+
+/**
+ * Fixed-point prices count ten-thousandths, the feed's own four decimal precision.
+ */
+constexpr std::int64_t priceScale = 10000;
+
+/**
+ * @brief A bar with integer fields: prices in ten-thousandths, volume as a share count.
+ *
+ * Sums of fixedBar fields are exact, so aggregates built on them never drift and come out
+ * bit-identical on every run and platform. Prices up to about 9e14 fit in an int64.
+ */
+struct fixedBar {
+    timestamp time;
+    std::int64_t open, close, high, low;
+    std::uint64_t volume;
+
+    fixedBar() : time(0), open(0), close(0), high(0), low(0), volume(0) {}
+    fixedBar(timestamp time, std::int64_t open, std::int64_t close, std::int64_t high, std::int64_t low, std::uint64_t volume)
+        : time(time), open(open), close(close), high(high), low(low), volume(volume) {}
+
+    /**
+     * Converts a floating point bar, rounding prices to the nearest ten-thousandth and
+     * volume to the nearest share.
+     *
+     * @param d The bar.
+     * @return The fixed-point bar.
+     */
+    static fixedBar fromData(const data& d) {
+        return {d.time, std::llround(d.open * priceScale), std::llround(d.close * priceScale),
+                std::llround(d.high * priceScale), std::llround(d.low * priceScale),
+                static_cast<std::uint64_t>(std::llround(d.volume))};
+    }
+
+    /**
+     * @return The bar as floating point; each price is the correctly rounded double of its decimal.
+     */
+    data toData() const {
+        return {time, static_cast<double>(open) / priceScale, static_cast<double>(close) / priceScale,
+                static_cast<double>(high) / priceScale, static_cast<double>(low) / priceScale,
+                static_cast<double>(volume)};
+    }
+};
+
+#endif //FIXEDBAR_H
@@ -0,0 +1,338 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "ingest.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "decimalParse.h"
+#include "mappedFile.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+/**
+ * @class TimeSeriesSax
+ * @brief SAX handler that turns the bars of a time series section into `data` records.
+ *
+ * Nesting depth tells the handler what each key means: depth 1 keys name the top level
+ * sections, depth 2 keys inside the time series are bar timestamps and depth 3 keys are
+ * the numbered fields of one bar ("1. open" ... "5. volume").
+ */
+class TimeSeriesSax : public nlohmann::json_sax<json> {
+public:
+    TimeSeriesSax(data* out, std::size_t capacity) : out(out), capacity(capacity) {}
+
+    std::size_t count = 0;
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+    bool start_array(std::size_t) override { return true; }
+    bool end_array() override { return true; }
+
+    bool start_object(std::size_t) override {
+        depth++;
+        if (inSeries && depth == 3) {
+            bar = data();
+            bar.time = barTime;
+            seen = 0;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (inSeries && depth == 3) {
+            // deliberate truncation: a full buffer ends the parse, keeping the newest bars
+            if (count == capacity) return false;
+            // parseBar rejects a bar with a missing field, and so must this path
+            if (seen != allFields) throw std::runtime_error("Malformed bar field");
+            out[count++] = bar;
+        } else if (depth == 2) {
+            inSeries = false;
+        }
+        depth--;
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        if (depth == 1) {
+            inSeries = val.compare(0, 11, "Time Series") == 0;
+        } else if (inSeries && depth == 2) {
+            barTime = parseTimestamp(val);
+        } else if (inSeries && depth == 3) {
+            // "1. open", "2. high", "3. low", "4. close", "5. volume"
+            field = val.empty() ? -1 : val[0] - '1';
+        }
+        return true;
+    }
+
+    bool string(string_t& val) override {
+        if (!inSeries || depth != 3 || field < 0 || field > 4) return true;
+        seen |= 1u << field;
+        switch (field) {
+            case 0: bar.open = parsePrice(val); break;
+            case 1: bar.high = parsePrice(val); break;
+            case 2: bar.low = parsePrice(val); break;
+            case 3: bar.close = parsePrice(val); break;
+            case 4: bar.volume = parseVolume(val); break;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        throw std::runtime_error(std::string("JSON parsing error: ") + ex.what());
+    }
+
+private:
+    data* out;
+    std::size_t capacity;
+    int depth = 0;
+    bool inSeries = false;
+    int field = -1;
+    unsigned seen = 0; // one bit per field of the current bar
+    static constexpr unsigned allFields = 0x1F;
+    timestamp barTime = 0;
+    data bar;
+};
+
+} // namespace
+
+TimeSeriesScanner::TimeSeriesScanner(std::string_view document)
+    : pos(document.data()), end(document.data() + document.size()), inSeries(false) {
+    skipWhitespace();
+    if (pos == end) return;
+    expect('{');
+    skipWhitespace();
+    if (pos < end && *pos == '}') return;
+
+    while (true) {
+        std::string_view key = readString();
+        skipWhitespace();
+        expect(':');
+        skipWhitespace();
+        if (key.starts_with("Time Series")) {
+            expect('{');
+            inSeries = true;
+            foundSeries = true;
+            return;
+        }
+        if (key == "Meta Data" && pos < end && *pos == '{') {
+            readMeta();
+        } else if ((key == "Note" || key == "Information" || key == "Error Message") && pos < end && *pos == '"') {
+            noticeText = readString();
+        } else {
+            skipValue();
+        }
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            ++pos;
+            skipWhitespace();
+            continue;
+        }
+        expect('}');
+        return;
+    }
+}
+
+bool TimeSeriesScanner::next(rawBar& bar) {
+    if (!inSeries) return false;
+    skipWhitespace();
+    if (pos < end && *pos == ',') {
+        ++pos;
+        skipWhitespace();
+    }
+    if (pos < end && *pos == '}') {
+        ++pos;
+        inSeries = false;
+        return false;
+    }
+
+    bar = rawBar();
+    bar.time = readString();
+    skipWhitespace();
+    expect(':');
+    skipWhitespace();
+    expect('{');
+    skipWhitespace();
+    if (pos < end && *pos == '}') {
+        ++pos;
+        return true;
+    }
+
+    while (true) {
+        std::string_view key = readString();
+        skipWhitespace();
+        expect(':');
+        skipWhitespace();
+        if (pos < end && *pos == '"' && !key.empty()) {
+            std::string_view value = readString();
+            // "1. open", "2. high", "3. low", "4. close", "5. volume"
+            switch (key[0]) {
+                case '1': bar.open = value; break;
+                case '2': bar.high = value; break;
+                case '3': bar.low = value; break;
+                case '4': bar.close = value; break;
+                case '5': bar.volume = value; break;
+                default: break;
+            }
+        } else {
+            skipValue();
+        }
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            ++pos;
+            skipWhitespace();
+            continue;
+        }
+        expect('}');
+        return true;
+    }
+}
+
+void TimeSeriesScanner::skipWhitespace() {
+    while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) {
+        ++pos;
+    }
+}
+
+void TimeSeriesScanner::expect(char c) {
+    if (pos == end || *pos != c) {
+        throw std::runtime_error(std::string("Malformed JSON: expected '") + c + "'");
+    }
+    ++pos;
+}
+
+std::string_view TimeSeriesScanner::readString() {
+    expect('"');
+    const char* start = pos;
+    while (true) {
+        const void* quote = std::memchr(pos, '"', end - pos);
+        if (!quote) throw std::runtime_error("Malformed JSON: unterminated string");
+        pos = static_cast<const char*>(quote);
+        // a quote preceded by an odd number of backslashes is escaped
+        const char* back = pos;
+        while (back > start && back[-1] == '\\') --back;
+        if ((pos - back) % 2 == 0) break;
+        ++pos;
+    }
+    std::string_view value(start, pos - start);
+    ++pos;
+    return value;
+}
+
+void TimeSeriesScanner::skipValue() {
+    int nesting = 0;
+    do {
+        if (pos == end) throw std::runtime_error("Malformed JSON: unexpected end of document");
+        switch (*pos) {
+            case '"':
+                readString();
+                continue;
+            case '{':
+            case '[':
+                ++nesting;
+                break;
+            case '}':
+            case ']':
+                if (nesting == 0) return;
+                --nesting;
+                break;
+            case ',':
+                if (nesting == 0) return;
+                break;
+            default:
+                break;
+        }
+        ++pos;
+    } while (nesting > 0 || (pos < end && *pos != ',' && *pos != '}' && *pos != ']'));
+}
+
+void TimeSeriesScanner::readMeta() {
+    expect('{');
+    skipWhitespace();
+    if (pos < end && *pos == '}') {
+        ++pos;
+        return;
+    }
+    while (true) {
+        std::string_view key = readString();
+        skipWhitespace();
+        expect(':');
+        skipWhitespace();
+        if (pos < end && *pos == '"') {
+            std::string_view value = readString();
+            if (key.ends_with("Symbol")) metaData.symbol = value;
+            else if (key.ends_with("Last Refreshed")) metaData.lastRefreshed = value;
+            else if (key.ends_with("Interval")) metaData.interval = value;
+            else if (key.ends_with("Time Zone")) metaData.timeZone = value;
+        } else {
+            skipValue();
+        }
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            ++pos;
+            skipWhitespace();
+            continue;
+        }
+        expect('}');
+        return;
+    }
+}
+
+data parseBar(const rawBar& bar) {
+    return {parseTimestamp(bar.time), parsePrice(bar.open), parsePrice(bar.close),
+            parsePrice(bar.high), parsePrice(bar.low), parseVolume(bar.volume)};
+}
+
+fixedBar parseFixedBar(const rawBar& bar) {
+    fixedBar out;
+    out.time = parseTimestamp(bar.time);
+    if (!parseFixed4(bar.open, out.open) || !parseFixed4(bar.close, out.close) ||
+        !parseFixed4(bar.high, out.high) || !parseFixed4(bar.low, out.low) ||
+        !parseVolumeDigits(bar.volume, out.volume)) {
+        throw std::runtime_error("Malformed bar field");
+    }
+    return out;
+}
+
+std::size_t ingestTimeSeries(std::istream& in, data* out, std::size_t capacity) {
+    TimeSeriesSax handler(out, capacity);
+    json::sax_parse(in, &handler);
+    return handler.count;
+}
+
+std::size_t ingestTimeSeries(std::string_view text, data* out, std::size_t capacity) {
+    TimeSeriesScanner scanner(text);
+    rawBar bar;
+    std::size_t count = 0;
+    while (count < capacity && scanner.next(bar)) {
+        out[count++] = parseBar(bar);
+    }
+    return count;
+}
+
+std::size_t loadBars(const std::string& path, data* out, std::size_t capacity) {
+    MappedFile file(path);
+    return ingestTimeSeries(file.view(), out, capacity);
+}
+
+std::vector<data> loadBars(const std::string& path) {
+    MappedFile file(path);
+    TimeSeriesScanner scanner(file.view());
+    std::vector<data> bars;
+    // a pretty-printed bar takes roughly 200 bytes of response
+    bars.reserve(file.size() / 200);
+    rawBar bar;
+    while (scanner.next(bar)) {
+        bars.push_back(parseBar(bar));
+    }
+    return bars;
+}
@@ -0,0 +1,174 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "data.h"
+#include "fixedBar.h"
+
+/**
+ * @brief One bar of a time series section, as views into the document it was scanned from.
+ *
+ * Nothing is copied or converted: every member points at the raw characters between the
+ * quotes in the source document, so the views are only valid while that document is.
+ */
+struct rawBar {
+    std::string_view time;
+    std::string_view open, high, low, close, volume;
+};
+
+/**
+ * @brief The "Meta Data" section of a response, as views into the document.
+ *
+ * Members are empty when the response has no such section or field.
+ */
+struct feedMeta {
+    std::string_view symbol;        // "2. Symbol"
+    std::string_view lastRefreshed; // "3. Last Refreshed"
+    std::string_view interval;      // "4. Interval"
+    std::string_view timeZone;      // "6. Time Zone" for intraday, "5. Time Zone" for daily series
+};
+
+/**
+ * @class TimeSeriesScanner
+ * @brief Hand-rolled, zero-copy tokenizer for the "Time Series (...)" section of a response.
+ *
+ * The scanner walks the document bytes in place (typically a MappedFile) and yields each
+ * bar as a set of string views. It understands just enough JSON to skip the other top
+ * level sections and any unknown members, and does not decode string escapes, which never
+ * occur in timestamps or numeric fields.
+ */
+class TimeSeriesScanner {
+public:
+    /**
+     * Positions the scanner at the first bar of the document's time series section.
+     *
+     * @param document The whole JSON response.
+     * @throws std::runtime_error if the document is malformed.
+     */
+    explicit TimeSeriesScanner(std::string_view document);
+
+    /**
+     * Scans the next bar in feed order (newest first for Alpha Vantage).
+     *
+     * @param bar Receives the views of the bar.
+     * @return true if a bar was scanned, false once the section (or document) has no more bars.
+     * @throws std::runtime_error if the document is malformed.
+     */
+    bool next(rawBar& bar);
+
+    /**
+     * @return The "Meta Data" section, if it precedes the time series as Alpha Vantage sends it.
+     */
+    const feedMeta& meta() const { return metaData; }
+
+    /**
+     * @return Whether the document has a time series section, even an empty one.
+     */
+    bool hasSeries() const { return foundSeries; }
+
+    /**
+     * @return The text of a "Note", "Information" or "Error Message" member before the time
+     *         series (how Alpha Vantage reports throttling and bad calls with HTTP 200), or
+     *         an empty view if there is none.
+     */
+    std::string_view notice() const { return noticeText; }
+
+private:
+    const char* pos;
+    const char* end;
+    bool inSeries;
+    bool foundSeries = false;
+    feedMeta metaData;
+    std::string_view noticeText;
+
+    void skipWhitespace();
+    void expect(char c);
+    std::string_view readString();
+    void skipValue();
+    void readMeta();
+};
+
+/**
+ * @brief Converts a scanned bar into a `data` record.
+ *
+ * @param bar The views of the bar.
+ * @return The parsed bar, including its timestamp.
+ * @throws std::runtime_error if a field is not a well-formed number.
+ */
+data parseBar(const rawBar& bar);
+
+/**
+ * @brief Converts a scanned bar straight into a fixed-point record, with no rounding.
+ *
+ * @param bar The views of the bar.
+ * @return The parsed bar, including its timestamp.
+ * @throws std::runtime_error if a price has more than four decimals or a field is not a
+ *         plain unsigned decimal.
+ */
+fixedBar parseFixedBar(const rawBar& bar);
+
+/**
+ * @brief Streams the "Time Series (...)" section of an Alpha Vantage response into bars.
+ *
+ * The document is consumed with nlohmann::json::sax_parse, so no DOM is ever built:
+ * each bar is decoded as its fields go past and written straight into the caller's
+ * buffer together with its parsed timestamp. Bars are emitted in feed order, which for
+ * Alpha Vantage is newest first. Parsing stops once the buffer is full, so a short buffer
+ * keeps the most recent bars.
+ *
+ * Documents without a time series section (e.g. "Note" or "Error Message" responses)
+ * yield zero bars.
+ *
+ * @param in The stream holding the JSON document.
+ * @param out The buffer to receive the bars.
+ * @param capacity The number of bars `out` can hold.
+ * @return The number of bars written to `out`.
+ * @throws std::runtime_error if the document is not valid JSON or a bar is malformed or
+ *         missing one of its five fields.
+ */
+std::size_t ingestTimeSeries(std::istream& in, data* out, std::size_t capacity);
+
+/**
+ * @brief Parses the time series section of an in-memory response (e.g. an HTTP body) into bars.
+ *
+ * The text is walked in place with TimeSeriesScanner rather than through the SAX parser.
+ *
+ * @see ingestTimeSeries(std::istream&, data*, std::size_t)
+ */
+std::size_t ingestTimeSeries(std::string_view text, data* out, std::size_t capacity);
+
+/**
+ * @brief Loads the bars of a recorded response file.
+ *
+ * The file is memory mapped and scanned in place, so throughput is bound by the file size
+ * rather than by stream buffering, and nothing is echoed to stdout.
+ *
+ * @param path The response file to load.
+ * @param out The buffer to receive the bars.
+ * @param capacity The number of bars `out` can hold.
+ * @return The number of bars written to `out`, in feed order.
+ * @throws std::runtime_error if the file cannot be mapped or is malformed.
+ */
+std::size_t loadBars(const std::string& path, data* out, std::size_t capacity);
+
+/**
+ * @brief Loads every bar of a recorded response file.
+ *
+ * Unlike the fixed-capacity overload nothing is dropped: the buffer is sized from the
+ * mapped file and grows as the series is scanned.
+ *
+ * @param path The response file to load.
+ * @return The bars of the file, in feed order.
+ * @throws std::runtime_error if the file cannot be mapped or is malformed.
+ */
+std::vector<data> loadBars(const std::string& path);
+
+#endif //INGEST_H
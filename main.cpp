@@ -1,7 +1,12 @@
 
 #include <chrono>
 #include <thread>
+#include <vector>
 #include "apiaccess.h"
+#include "barCodec.h"
+#include "barSeries.h"
+#include "barStore.h"
+#include "ingest.h"
 #include "MovingAvg.h"
 
 /**
@@ -11,46 +16,78 @@
  */
 #include <iostream>
 #include "circularDeque.h"
-int main() {
+
+/**
+ * Replays bars oldest first through the engine and prints the moving averages after each one.
+ *
+ * @param engine The moving average engine to feed.
+ * @param nextBar Fills in the next bar in ascending time order, returning false when there are no more.
+ */
+template <typename NextBar>
+void replay(MovingAvg& engine, NextBar nextBar) {
+    data prev;
+    data d;
+    for (bool first = true; nextBar(d); first = false) {
+        if (!first && missingBars(prev, d) > 0) {
+            std::cout << "-- " << missingBars(prev, d) << " bar gap before " << formatTimestamp(d.time) << "\n";
+        }
+        engine.add(d);
+        prev = d;
+
+        std::cout << formatTimestamp(d.time)
+                  << " | OpenSMA: " << engine.openSMA()
+                  << " | HighSMA: " << engine.highSMA()
+                  << " | LowSMA: " << engine.lowSMA()
+                  << " | CloseSMA: " << engine.closeSMA()
+                  << " | VolumeSMA: " << engine.volumeSMA()
+                  << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
 
     //MemoryPool<data> pool(15); // memory efficiency
     MovingAvg engine(6);
-    json dat = getAPIData();
-    const json& TSPMOIFTHISDONTWORK = dat["Time Series (5min)"];
-    std::cout << "test 1" << std::endl;
-    std::vector<std::string> timestamps;
-    std::cout << "test 2" << std::endl;
-    for (auto it = TSPMOIFTHISDONTWORK.begin(); it != TSPMOIFTHISDONTWORK.end(); ++it) {
-        timestamps.push_back(it.key());
-    }
-    //std::cout << timestamps[0] << std::endl;
-    std::cout << "test 3" << std::endl;
-    std::sort(timestamps.begin(), timestamps.end());
-    std::cout << "test 3.4" << std::endl;
+    const std::string path = argc > 1 ? argv[1] : "sample.json";
 
-    if (!dat.contains("Time Series (5min)")) {
-        std::cerr << "Key 'Time Series (5min)' not found in JSON.\n";
-        return 1;
-    }
+    try {
+        if (path.ends_with(".bars")) {
+            // columnar store written by APIEXP_convert, already oldest first
+            BarStore store(path);
+            std::size_t i = 0;
+            replay(engine, [&](data& d) {
+                if (i == store.size()) return false;
+                d = store.bar(i++);
+                return true;
+            });
+            return 0;
+        }
+        if (path.ends_with(".barz")) {
+            // compressed archive, decoded one bar at a time
+            CompressedBarFile archive(path);
+            BarDecoder decoder = archive.decoder();
+            replay(engine, [&](data& d) { return decoder.next(d); });
+            return 0;
+        }
 
-    for (const std::string& time : timestamps) {
-        try {
-            std::cout << "test 4" << std::endl;
-            data d = retrievePrice(time, TSPMOIFTHISDONTWORK);
-            engine.add(d);
-
-            std::cout << time
-                      << " | OpenSMA: " << engine.openSMA()
-                      << " | HighSMA: " << engine.highSMA()
-                      << " | LowSMA: " << engine.lowSMA()
-                      << " | CloseSMA: " << engine.closeSMA()
-                      << " | VolumeSMA: " << engine.volumeSMA()
-                      << "\n";
-        } catch (const std::exception& e) {
-            std::cerr << "Skipping " << time << ": " << e.what() << std::endl;
+        std::vector<data> bars = loadBars(path);
+        if (bars.empty()) {
+            std::cerr << "No time series found in " << path << "\n";
+            return 1;
         }
+
+        // the feed is newest first, replay it oldest first
+        sortBars(bars.data(), bars.data() + bars.size());
+        std::size_t i = 0;
+        replay(engine, [&](data& d) {
+            if (i == bars.size()) return false;
+            d = bars[i++];
+            return true;
+        });
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
     }
-    std::cout << "test 4" << std::endl;
 
     //data trough[engine.maxSize];
     //json SampleJSON = retrieveRaw(target);
@@ -0,0 +1,62 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "mappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) : address(nullptr), length(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to stat " + path + ": " + std::strerror(err));
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            throw std::runtime_error("Failed to map " + path + ": " + std::strerror(err));
+        }
+        ::madvise(mapping, length, MADV_SEQUENTIAL);
+        address = static_cast<const char*>(mapping);
+    }
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (address) {
+        ::munmap(const_cast<char*>(address), length);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : address(std::exchange(other.address, nullptr)), length(std::exchange(other.length, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        if (address) {
+            ::munmap(const_cast<char*>(address), length);
+        }
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
@@ -0,0 +1,60 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The file is mapped with mmap(PROT_READ, MAP_PRIVATE) and advised for sequential access,
+ * so parsers can walk its bytes in place instead of copying them through an ifstream buffer.
+ * Views handed out by `view()` stay valid for as long as the MappedFile is alive.
+ */
+class MappedFile {
+public:
+    /**
+     * Maps the file at `path`.
+     *
+     * @param path The file to map.
+     * @throws std::runtime_error if the file cannot be opened, inspected or mapped.
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @return A pointer to the first mapped byte, or nullptr for an empty file.
+     */
+    const char* data() const { return address; }
+
+    /**
+     * @return The length of the file in bytes.
+     */
+    std::size_t size() const { return length; }
+
+    /**
+     * @return The whole mapping as a string view.
+     */
+    std::string_view view() const { return {address, length}; }
+
+private:
+    const char* address;
+    std::size_t length;
+};
+
+#endif //MAPPEDFILE_H
@@ -0,0 +1,71 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "pollMerger.h"
+
+#include <algorithm>
+#include "barSeries.h"
+#include "ingest.h"
+
+namespace {
+
+bool sameValues(const data& a, const data& b) {
+    return a.open == b.open && a.close == b.close && a.high == b.high && a.low == b.low && a.volume == b.volume;
+}
+
+} // namespace
+
+PollMerger::PollMerger(std::size_t history) : history(history) {}
+
+mergeResult PollMerger::merge(const std::string& symbol, std::string_view response,
+                              const std::function<void(const data&)>& append) {
+    symbolState& state = symbols[symbol];
+    mergeResult result;
+
+    TimeSeriesScanner scanner(response);
+    if (!scanner.meta().lastRefreshed.empty()) {
+        result.lastRefreshed = parseTimestamp(scanner.meta().lastRefreshed);
+    }
+
+    const timestamp oldestKnown = state.recent.empty() ? state.last : state.recent.front().time;
+    state.fresh.clear();
+    rawBar raw;
+    while (scanner.next(raw)) {
+        const timestamp t = parseTimestamp(raw.time);
+        if (state.last != 0 && t < oldestKnown) break; // everything further back is older still
+        result.scanned++;
+
+        if (state.last == 0 || t > state.last) {
+            state.fresh.push_back(parseBar(raw));
+            continue;
+        }
+
+        auto it = std::lower_bound(state.recent.begin(), state.recent.end(), t,
+                                   [](const data& d, timestamp time) { return d.time < time; });
+        if (it == state.recent.end() || it->time != t) continue;
+        const data bar = parseBar(raw);
+        if (!sameValues(bar, *it)) {
+            result.revisions.push_back({*it, bar});
+            *it = bar;
+        }
+    }
+
+    // the feed is newest first; append oldest first
+    sortBars(state.fresh.data(), state.fresh.data() + state.fresh.size());
+    for (const data& bar : state.fresh) {
+        append(bar);
+        state.recent.push_back(bar);
+        if (state.recent.size() > history) state.recent.pop_front();
+    }
+    if (!state.fresh.empty()) {
+        state.last = state.fresh.back().time;
+    }
+    result.appended = state.fresh.size();
+    return result;
+}
+
+timestamp PollMerger::lastIngested(const std::string& symbol) const {
+    auto it = symbols.find(symbol);
+    return it == symbols.end() ? 0 : it->second.last;
+}
@@ -0,0 +1,82 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef POLLMERGER_H
+#define POLLMERGER_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "data.h"
+
+/**
+ * @brief A bar the feed changed after it had already been ingested.
+ */
+struct barRevision {
+    data previous;
+    data revised;
+};
+
+/**
+ * @brief Outcome of merging one poll response.
+ */
+struct mergeResult {
+    std::size_t appended = 0;           // new bars handed to the append callback
+    std::size_t scanned = 0;            // bars read from the response before stopping
+    timestamp lastRefreshed = 0;        // the response's "3. Last Refreshed", 0 if absent
+    std::vector<barRevision> revisions; // already ingested bars whose values changed
+};
+
+/**
+ * @class PollMerger
+ * @brief Merges repeated compact-window polls into an append-only bar stream per symbol.
+ *
+ * Every poll returns the whole compact window (about 100 bars), of which only one or two
+ * are new. The merger remembers, per symbol, the newest ingested timestamp and the last
+ * `history` bars. Because the feed is newest first, a response is scanned only until the
+ * first bar older than what is remembered; bars newer than the last ingested one are
+ * appended oldest first, and remembered bars whose values changed are reported as
+ * revisions instead of being appended a second time.
+ */
+class PollMerger {
+public:
+    /**
+     * @param history The number of ingested bars per symbol to keep for revision checks.
+     */
+    explicit PollMerger(std::size_t history = 100);
+
+    /**
+     * Merges one poll response for a symbol.
+     *
+     * @param symbol The ticker the response belongs to.
+     * @param response The raw response body.
+     * @param append Receives each new bar, oldest first.
+     * @return What the merge found.
+     * @throws std::runtime_error if the response is malformed.
+     */
+    mergeResult merge(const std::string& symbol, std::string_view response,
+                      const std::function<void(const data&)>& append);
+
+    /**
+     * @param symbol The ticker.
+     * @return The timestamp of the newest bar ingested for the symbol, or 0 if none.
+     */
+    timestamp lastIngested(const std::string& symbol) const;
+
+private:
+    struct symbolState {
+        timestamp last = 0;
+        std::deque<data> recent;   // ascending time order
+        std::vector<data> fresh;   // scratch for the newest-first bars of one poll
+    };
+
+    std::size_t history;
+    std::unordered_map<std::string, symbolState> symbols;
+};
+
+#endif //POLLMERGER_H
@@ -0,0 +1,95 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "requestScheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+RequestScheduler::RequestScheduler(rateQuota quota, clock::time_point now)
+    : minute{quota.perMinute, quota.perMinute, quota.perMinute / 60.0},
+      day{quota.perDay, quota.perDay, quota.perDay / 86400.0},
+      refilled(now) {
+    // a bucket holding less than one token could never dispatch a request
+    if (!(quota.perMinute >= 1) || !(quota.perDay >= 1)) {
+        throw std::invalid_argument("Rate quota must allow at least one request");
+    }
+}
+
+bool RequestScheduler::submit(const std::string& symbol, timestamp lastBar, clock::time_point now) {
+    counters.submitted++;
+    auto it = queued.find(symbol);
+    if (it != queued.end()) {
+        counters.coalesced++;
+        // keep the older of the two staleness reports so the symbol is not pushed back
+        queueKey& key = it->second.first;
+        if (lastBar < std::get<0>(key)) {
+            queue.erase(key);
+            std::get<0>(key) = lastBar;
+            queue.insert(key);
+        }
+        return false;
+    }
+    queueKey key{lastBar, sequence++, symbol};
+    queue.insert(key);
+    queued.emplace(symbol, std::make_pair(std::move(key), now));
+    return true;
+}
+
+std::optional<std::string> RequestScheduler::poll(clock::time_point now) {
+    if (queue.empty()) return std::nullopt;
+    refill(now);
+    if (minute.tokens < 1 || day.tokens < 1) return std::nullopt;
+    minute.tokens -= 1;
+    day.tokens -= 1;
+
+    std::string symbol = std::get<2>(*queue.begin());
+    queue.erase(queue.begin());
+    auto it = queued.find(symbol);
+    const std::chrono::duration<double, std::milli> waited = now - it->second.second;
+    queued.erase(it);
+
+    counters.dispatched++;
+    counters.totalWaitMs += waited.count();
+    counters.maxWaitMs = std::max(counters.maxWaitMs, waited.count());
+    return symbol;
+}
+
+RequestScheduler::clock::duration RequestScheduler::timeUntilNext(clock::time_point now) {
+    if (queue.empty()) return clock::duration::max();
+    refill(now);
+    double seconds = 0;
+    for (const bucket* b : {&minute, &day}) {
+        if (b->tokens < 1) {
+            seconds = std::max(seconds, (1 - b->tokens) / b->perSecond);
+        }
+    }
+    return std::chrono::ceil<clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+void RequestScheduler::drain(const std::function<void(const std::string& symbol)>& fetch) {
+    while (!queue.empty()) {
+        if (std::optional<std::string> symbol = poll(clock::now())) {
+            fetch(*symbol);
+        } else {
+            std::this_thread::sleep_for(timeUntilNext(clock::now()));
+        }
+    }
+}
+
+schedulerStats RequestScheduler::stats() const {
+    schedulerStats snapshot = counters;
+    snapshot.queueDepth = queue.size();
+    return snapshot;
+}
+
+void RequestScheduler::refill(clock::time_point now) {
+    if (now <= refilled) return;
+    const double elapsed = std::chrono::duration<double>(now - refilled).count();
+    for (bucket* b : {&minute, &day}) {
+        b->tokens = std::min(b->capacity, b->tokens + elapsed * b->perSecond);
+    }
+    refilled = now;
+}
@@ -0,0 +1,129 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include "timestamp.h"
+
+/**
+ * @brief Request quota of an API key. The defaults are the free tier's limits.
+ */
+struct rateQuota {
+    double perMinute = 5;
+    double perDay = 25;
+};
+
+/**
+ * @brief Counters describing how a RequestScheduler has been spending its quota.
+ */
+struct schedulerStats {
+    std::size_t queueDepth = 0;
+    std::size_t submitted = 0;
+    std::size_t coalesced = 0;
+    std::size_t dispatched = 0;
+    double totalWaitMs = 0;
+    double maxWaitMs = 0;
+
+    double meanWaitMs() const { return dispatched ? totalWaitMs / dispatched : 0; }
+};
+
+/**
+ * @class RequestScheduler
+ * @brief Token bucket scheduler that spends an API key's quota on the most useful fetches.
+ *
+ * Two buckets run side by side, one refilling `perMinute` tokens per minute and one
+ * refilling `perDay` tokens per day; a fetch needs a token from both. While no token is
+ * available, requests wait in a queue ordered by the timestamp of the last bar held for
+ * the symbol, so the stalest symbol is fetched first. A request for a symbol that is
+ * already queued is coalesced into the queued one rather than spending a second token.
+ *
+ * Every method takes the current time as a parameter so tests can drive the clock; the
+ * defaults read the steady clock. The scheduler is not thread safe.
+ */
+class RequestScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @param quota The limits of the API key. Both buckets start full.
+     * @param now The current time.
+     * @throws std::invalid_argument if either limit is below one request.
+     */
+    explicit RequestScheduler(rateQuota quota = rateQuota(), clock::time_point now = clock::now());
+
+    /**
+     * Queues a fetch for `symbol`.
+     *
+     * @param symbol The ticker to fetch.
+     * @param lastBar The timestamp of the newest bar already held for the symbol (0 if none).
+     * @param now The current time.
+     * @return false if the request was coalesced into one already queued for the symbol.
+     */
+    bool submit(const std::string& symbol, timestamp lastBar, clock::time_point now = clock::now());
+
+    /**
+     * Takes the stalest queued symbol if the quota allows a fetch right now.
+     *
+     * @param now The current time.
+     * @return The symbol to fetch, or std::nullopt if the queue is empty or no token is available.
+     */
+    std::optional<std::string> poll(clock::time_point now = clock::now());
+
+    /**
+     * @param now The current time.
+     * @return How long until poll() can next hand out a symbol; zero if it can now, and
+     *         clock::duration::max() if the queue is empty.
+     */
+    clock::duration timeUntilNext(clock::time_point now = clock::now());
+
+    /**
+     * Fetches every queued symbol, sleeping between fetches as the quota requires.
+     *
+     * @param fetch Called once per dequeued symbol.
+     */
+    void drain(const std::function<void(const std::string& symbol)>& fetch);
+
+    /**
+     * @return The number of symbols waiting to be fetched.
+     */
+    std::size_t queueDepth() const { return queue.size(); }
+
+    /**
+     * @return A snapshot of the scheduler's counters.
+     */
+    schedulerStats stats() const;
+
+private:
+    // ordered by (last bar held, submission order, symbol): stalest first, then FIFO
+    using queueKey = std::tuple<timestamp, std::uint64_t, std::string>;
+
+    struct bucket {
+        double capacity;
+        double tokens;
+        double perSecond;
+    };
+
+    bucket minute;
+    bucket day;
+    clock::time_point refilled;
+
+    std::set<queueKey> queue;
+    std::unordered_map<std::string, std::pair<queueKey, clock::time_point>> queued;
+    std::uint64_t sequence = 0;
+    schedulerStats counters;
+
+    void refill(clock::time_point now);
+};
+
+#endif //REQUESTSCHEDULER_H
@@ -0,0 +1,112 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "responseLog.h"
+
+#include <stdexcept>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string sliceKey(const std::string& symbol, const std::string& month) {
+    return symbol + '\n' + month;
+}
+
+} // namespace
+
+ResponseRecorder::ResponseRecorder(const std::string& path) : out(path, std::ios::app) {
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+}
+
+void ResponseRecorder::record(const std::string& symbol, long status, const std::string& body, double latencyMs,
+                              const std::string& month) {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    record({std::chrono::duration_cast<std::chrono::milliseconds>(now).count(), symbol, latencyMs, status, body, month});
+}
+
+void ResponseRecorder::record(const recordedResponse& response) {
+    json line = {
+        {"fetched_at_ms", response.fetchedAtMs},
+        {"symbol", response.symbol},
+        {"latency_ms", response.latencyMs},
+        {"status", response.status},
+        {"body", response.body},
+    };
+    if (!response.month.empty()) {
+        line["month"] = response.month;
+    }
+    const std::string text = line.dump();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    out << text << '\n';
+    out.flush();
+}
+
+ResponseReplayer::ResponseReplayer(const std::string& path, double speed) : speed(speed) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open " + path);
+    }
+    std::string text;
+    std::size_t lineNumber = 0;
+    while (std::getline(in, text)) {
+        lineNumber++;
+        if (text.empty()) continue;
+        try {
+            const json line = json::parse(text);
+            recordedResponse response;
+            response.fetchedAtMs = line.at("fetched_at_ms").get<std::int64_t>();
+            response.symbol = line.at("symbol").get<std::string>();
+            response.latencyMs = line.value("latency_ms", 0.0);
+            response.status = line.value("status", 200L);
+            response.body = line.at("body").get<std::string>();
+            response.month = line.value("month", std::string());
+            bySlice[sliceKey(response.symbol, response.month)].push_back(responses.size());
+            responses.push_back(std::move(response));
+        } catch (const json::exception& e) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+}
+
+std::optional<recordedResponse> ResponseReplayer::next() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (cursor == responses.size()) return std::nullopt;
+    const recordedResponse& response = responses[cursor++];
+    const auto due = dueTime(response);
+    lock.unlock();
+    std::this_thread::sleep_until(due);
+    return response;
+}
+
+std::optional<recordedResponse> ResponseReplayer::fetch(const std::string& symbol, const std::string& month) {
+    const std::string key = sliceKey(symbol, month);
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = bySlice.find(key);
+    if (it == bySlice.end()) return std::nullopt;
+    std::size_t& position = sliceCursor[key];
+    if (position == it->second.size()) return std::nullopt;
+    const recordedResponse& response = responses[it->second[position++]];
+    const auto due = dueTime(response);
+    lock.unlock();
+    std::this_thread::sleep_until(due);
+    return response;
+}
+
+std::chrono::steady_clock::time_point ResponseReplayer::dueTime(const recordedResponse& response) {
+    const auto now = std::chrono::steady_clock::now();
+    if (speed <= 0) return now;
+    if (!started) {
+        started = now;
+        originMs = response.fetchedAtMs;
+        return now;
+    }
+    const std::chrono::duration<double, std::milli> offset((response.fetchedAtMs - originMs) / speed);
+    return *started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+}
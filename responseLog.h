@@ -0,0 +1,130 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef RESPONSELOG_H
+#define RESPONSELOG_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief One raw API response as stored in a JSON Lines log.
+ *
+ * Each line of the log is an object with the members
+ * {"fetched_at_ms", "symbol", "latency_ms", "status", "body"}, plus "month" for a month
+ * slice of a backfill.
+ */
+struct recordedResponse {
+    std::int64_t fetchedAtMs = 0; // wall clock at completion, milliseconds since the Unix epoch
+    std::string symbol;
+    double latencyMs = 0;
+    long status = 0;
+    std::string body;
+    std::string month; // "YYYY-MM" of a month slice; empty for the latest window
+};
+
+/**
+ * @class ResponseRecorder
+ * @brief Appends raw API responses to a JSON Lines log (conventionally requests.jsonl).
+ *
+ * Lines are written and flushed one response at a time, so a crashed session still leaves
+ * a readable log. Safe to share between fetch threads.
+ */
+class ResponseRecorder {
+public:
+    /**
+     * Opens `path` for appending.
+     *
+     * @param path The log file; created if missing.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    explicit ResponseRecorder(const std::string& path);
+
+    /**
+     * Appends one response, stamped with the current wall clock time.
+     *
+     * @param symbol The ticker that was fetched.
+     * @param status The HTTP status code.
+     * @param body The raw response body.
+     * @param latencyMs How long the fetch took.
+     * @param month The month slice fetched, "YYYY-MM"; empty for the latest window.
+     */
+    void record(const std::string& symbol, long status, const std::string& body, double latencyMs,
+                const std::string& month = "");
+
+    /**
+     * Appends one response as given.
+     *
+     * @param response The response to append.
+     */
+    void record(const recordedResponse& response);
+
+private:
+    std::mutex mutex;
+    std::ofstream out;
+};
+
+/**
+ * @class ResponseReplayer
+ * @brief Serves the responses of a JSON Lines log back in their recorded order.
+ *
+ * Pacing follows the recorded fetch times scaled by `speed`: 1 replays in real time, 10 at
+ * ten times the recorded rate, and 0 (the default) as fast as possible. The replay clock
+ * starts at the first request. Safe to share between fetch threads; a paced response is
+ * waited for outside the lock, so one thread's wait does not hold back the others.
+ */
+class ResponseReplayer {
+public:
+    /**
+     * Loads a log.
+     *
+     * @param path The log file.
+     * @param speed The replay rate relative to the recording; 0 disables pacing.
+     * @throws std::runtime_error if the file cannot be read or a line is malformed.
+     */
+    explicit ResponseReplayer(const std::string& path, double speed = 0);
+
+    /**
+     * Serves the next response in log order, waiting until it is due.
+     *
+     * @return The response, or std::nullopt once the log is exhausted.
+     */
+    std::optional<recordedResponse> next();
+
+    /**
+     * Serves the next recorded response for `symbol` and `month`, waiting until it is due.
+     * Responses are matched on both, so each slice of a replayed backfill gets its own recording.
+     *
+     * @param symbol The ticker being fetched.
+     * @param month The month slice being fetched, "YYYY-MM"; empty for the latest window.
+     * @return The response, or std::nullopt once the slice has no responses left.
+     */
+    std::optional<recordedResponse> fetch(const std::string& symbol, const std::string& month = "");
+
+    /**
+     * @return The number of responses in the log.
+     */
+    std::size_t size() const { return responses.size(); }
+
+private:
+    std::mutex mutex;
+    std::vector<recordedResponse> responses;
+    std::unordered_map<std::string, std::vector<std::size_t>> bySlice; // keyed by symbol '\n' month
+    std::unordered_map<std::string, std::size_t> sliceCursor;
+    std::size_t cursor = 0;
+    double speed;
+    std::optional<std::chrono::steady_clock::time_point> started;
+    std::int64_t originMs = 0; // recorded fetch time of the first response served
+
+    std::chrono::steady_clock::time_point dueTime(const recordedResponse& response);
+};
+
+#endif //RESPONSELOG_H
@@ -0,0 +1,128 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef RINGSTORAGE_H
+#define RINGSTORAGE_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Default circularDeque storage: a plain heap array of exactly the requested size.
+ */
+template <typename T>
+class heapStorage {
+public:
+    static constexpr bool mirrored = false;
+
+    explicit heapStorage(std::size_t requested) : slots(requested), array(new T[requested]) {}
+    ~heapStorage() { delete[] array; }
+
+    heapStorage(const heapStorage&) = delete;
+    heapStorage& operator=(const heapStorage&) = delete;
+
+    T* data() const { return array; }
+    std::size_t size() const { return slots; }
+
+    void swap(heapStorage& other) noexcept {
+        std::swap(slots, other.slots);
+        std::swap(array, other.array);
+    }
+
+private:
+    std::size_t slots;
+    T* array;
+};
+
+#ifdef __linux__
+/**
+ * @brief circularDeque storage whose array is mapped twice, back to back, in virtual memory.
+ *
+ * One memfd holds the elements and is mapped at [base, base + bytes) and again at
+ * [base + bytes, base + 2 * bytes). Element i and element i + size() are then the same
+ * memory, so any run of up to size() elements starting anywhere in the first mapping is
+ * contiguous: a ring's live window never wraps. The byte size must be a whole number of
+ * pages, so the slot count is rounded up to a multiple of lcm(page size, sizeof(T)) / sizeof(T).
+ *
+ * The same object is visible at two addresses, so T must be trivially copyable.
+ */
+template <typename T>
+class mirroredStorage {
+    static_assert(std::is_trivially_copyable_v<T>, "mirrored storage aliases elements; T must be trivially copyable");
+
+public:
+    static constexpr bool mirrored = true;
+
+    /**
+     * @param requested The minimum number of elements.
+     * @throws std::runtime_error if the memfd cannot be created or mapped.
+     */
+    explicit mirroredStorage(std::size_t requested) {
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t unit = std::lcm(page, sizeof(T));
+        bytes = (requested * sizeof(T) + unit - 1) / unit * unit;
+        if (bytes == 0) bytes = unit;
+        slots = bytes / sizeof(T);
+
+        const int fd = ::memfd_create("circularDeque", MFD_CLOEXEC);
+        if (fd < 0) fail("create", errno, -1, nullptr);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) fail("size", errno, fd, nullptr);
+
+        // reserve both halves at once so nothing else can land in between
+        void* reserved = ::mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED) fail("reserve", errno, fd, nullptr);
+        base = static_cast<char*>(reserved);
+        for (char* half : {base, base + bytes}) {
+            if (::mmap(half, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                fail("map", errno, fd, base);
+            }
+        }
+        // both mappings keep their own reference to the memfd
+        ::close(fd);
+
+        for (std::size_t i = 0; i < slots; ++i) {
+            ::new (static_cast<void*>(data() + i)) T();
+        }
+    }
+
+    ~mirroredStorage() { ::munmap(base, 2 * bytes); }
+
+    mirroredStorage(const mirroredStorage&) = delete;
+    mirroredStorage& operator=(const mirroredStorage&) = delete;
+
+    T* data() const { return reinterpret_cast<T*>(base); }
+    std::size_t size() const { return slots; }
+
+    void swap(mirroredStorage& other) noexcept {
+        std::swap(base, other.base);
+        std::swap(bytes, other.bytes);
+        std::swap(slots, other.slots);
+    }
+
+private:
+    char* base = nullptr;
+    std::size_t bytes = 0;
+    std::size_t slots = 0;
+
+    [[noreturn]] void fail(const char* step, int err, int fd, char* mapping) {
+        if (mapping) ::munmap(mapping, 2 * bytes);
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error(std::string("Failed to ") + step + " mirrored ring storage: " + std::strerror(err));
+    }
+};
+#endif
+
+#endif //RINGSTORAGE_H
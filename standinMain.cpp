@@ -0,0 +1,67 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include <csignal>
+#include <iostream>
+#include <string>
+#include "standinServer.h"
+
+/**
+ * Runs a StandinServer until interrupted.
+ *
+ * usage: APIEXP_standin [--port N] [--latency-ms N] [--jitter-ms N] [--error-rate X]
+ *                       [--rate-limit-every N] [--compact-bars N] [--full-bars N]
+ *                       [--bars file.bars] [--seed N] [--slow-symbol SYM --slow-ms N]
+ */
+int main(int argc, char** argv) {
+    standinOptions options;
+    options.port = 8080;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string flag = argv[i];
+            if (i + 1 == argc) throw std::invalid_argument("missing value for " + flag);
+            const std::string value = argv[++i];
+            if (flag == "--port") options.port = static_cast<unsigned short>(std::stoi(value));
+            else if (flag == "--latency-ms") options.latencyMs = std::stoi(value);
+            else if (flag == "--jitter-ms") options.jitterMs = std::stoi(value);
+            else if (flag == "--error-rate") options.errorRate = std::stod(value);
+            else if (flag == "--rate-limit-every") options.rateLimitEvery = std::stoi(value);
+            else if (flag == "--compact-bars") options.compactBars = std::stoul(value);
+            else if (flag == "--full-bars") options.fullBars = std::stoul(value);
+            else if (flag == "--bars") options.barStorePath = value;
+            else if (flag == "--seed") options.seed = std::stoull(value);
+            else if (flag == "--slow-symbol") options.slowSymbol = value;
+            else if (flag == "--slow-ms") options.slowMs = std::stoi(value);
+            else throw std::invalid_argument("unknown flag " + flag);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    // block in every thread so only sigwait below sees them
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    StandinServer server(options);
+    try {
+        server.start();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Serving TIME_SERIES_INTRADAY on " << server.url() << std::endl;
+
+    int received;
+    sigwait(&signals, &received);
+    server.stop();
+
+    const standinStats stats = server.stats();
+    std::cout << stats.requests << " requests, " << stats.errors << " errors, "
+              << stats.rateLimited << " rate limited" << std::endl;
+    return 0;
+}
@@ -0,0 +1,394 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#include "standinServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "barSeries.h"
+
+namespace {
+
+/**
+ * Decodes the two hex digits of a "%XX" escape.
+ *
+ * @return false if `digits` is not exactly two hex digits.
+ */
+bool decodeEscape(std::string_view digits, char& out) {
+    unsigned value = 0;
+    const char* last = digits.data() + digits.size();
+    auto [ptr, ec] = std::from_chars(digits.data(), last, value, 16);
+    if (digits.size() != 2 || ec != std::errc() || ptr != last) return false;
+    out = static_cast<char>(value);
+    return true;
+}
+
+/**
+ * Returns false if any '%' in a query string does not start a valid "%XX" escape.
+ */
+bool wellFormedQuery(std::string_view query) {
+    char decoded;
+    for (std::size_t i = query.find('%'); i != std::string_view::npos; i = query.find('%', i + 1)) {
+        if (!decodeEscape(query.substr(i + 1, 2), decoded)) return false;
+    }
+    return true;
+}
+
+/**
+ * Returns the decoded value of `name` in a query string, or an empty string if absent.
+ *
+ * @throws std::invalid_argument if the value holds a malformed "%XX" escape.
+ */
+std::string queryValue(std::string_view query, std::string_view name) {
+    std::size_t pos = 0;
+    while (pos <= query.size()) {
+        std::size_t end = query.find('&', pos);
+        if (end == std::string_view::npos) end = query.size();
+        std::string_view pair = query.substr(pos, end - pos);
+        if (pair.size() > name.size() && pair.starts_with(name) && pair[name.size()] == '=') {
+            std::string value;
+            for (std::size_t i = name.size() + 1; i < pair.size(); ++i) {
+                if (pair[i] == '%') {
+                    char decoded;
+                    if (!decodeEscape(pair.substr(i + 1, 2), decoded)) {
+                        throw std::invalid_argument("Malformed escape in query string");
+                    }
+                    value += decoded;
+                    i += 2;
+                } else {
+                    value += pair[i] == '+' ? ' ' : pair[i];
+                }
+            }
+            return value;
+        }
+        pos = end + 1;
+    }
+    return {};
+}
+
+/**
+ * A deterministic value in [0, 1) for a (symbol, slot) pair, so every poll agrees on history.
+ */
+double noise(std::uint64_t seed, std::int64_t slot) {
+    std::uint64_t x = seed ^ (static_cast<std::uint64_t>(slot) * 0x9E3779B97F4A7C15ULL);
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return static_cast<double>(x >> 11) / 9007199254740992.0;
+}
+
+/**
+ * Writes a whole buffer, retrying short writes.
+ */
+bool sendAll(int fd, std::string_view bytes) {
+    while (!bytes.empty()) {
+        const ssize_t sent = ::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+        if (sent <= 0) {
+            if (sent < 0 && errno == EINTR) continue;
+            return false;
+        }
+        bytes.remove_prefix(static_cast<std::size_t>(sent));
+    }
+    return true;
+}
+
+std::string httpResponse(int status, std::string_view reason, std::string_view body) {
+    std::string response = "HTTP/1.1 " + std::to_string(status) + " " + std::string(reason) + "\r\n";
+    response += "Content-Type: application/json\r\n";
+    response += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    response += "Connection: keep-alive\r\n\r\n";
+    response += body;
+    return response;
+}
+
+} // namespace
+
+StandinServer::StandinServer(standinOptions options) : options(std::move(options)), random(this->options.seed) {}
+
+StandinServer::~StandinServer() {
+    stop();
+}
+
+void StandinServer::start() {
+    if (running) return;
+    if (!options.barStorePath.empty()) {
+        store = std::make_unique<BarStore>(options.barStorePath);
+    }
+
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(std::string("Failed to create socket: ") + std::strerror(errno));
+    }
+    int yes = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(options.port);
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0) {
+        const int err = errno;
+        ::close(listenFd);
+        listenFd = -1;
+        throw std::runtime_error(std::string("Failed to bind stand-in server: ") + std::strerror(err));
+    }
+    socklen_t length = sizeof(address);
+    ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    boundPort = ntohs(address.sin_port);
+
+    running = true;
+    acceptor = std::thread(&StandinServer::acceptLoop, this);
+}
+
+void StandinServer::stop() {
+    if (!running.exchange(false)) return;
+    // wakes the blocked accept()
+    ::shutdown(listenFd, SHUT_RDWR);
+    ::close(listenFd);
+    listenFd = -1;
+    acceptor.join();
+
+    std::vector<std::thread> finished;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        for (int fd : connections) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        finished.swap(workers);
+    }
+    for (std::thread& worker : finished) {
+        worker.join();
+    }
+    // every worker is joined; drop their ids before a restart could see them reused
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    finishedWorkers.clear();
+}
+
+std::string StandinServer::url() const {
+    return "http://127.0.0.1:" + std::to_string(boundPort) + "/query";
+}
+
+standinStats StandinServer::stats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return counters;
+}
+
+void StandinServer::acceptLoop() {
+    while (running) {
+        const int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        int yes = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            counters.connections++;
+        }
+
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        if (!running) {
+            ::close(fd);
+            return;
+        }
+        reapWorkers();
+        connections.push_back(fd);
+        workers.emplace_back(&StandinServer::serve, this, fd);
+    }
+}
+
+void StandinServer::serve(int fd) {
+    try {
+        answerRequests(fd);
+    } catch (const std::exception&) {
+        // a request that cannot be answered drops its connection, never the whole server
+    }
+
+    // forget the descriptor before closing it, so stop() cannot shut down a recycled one
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        connections.erase(std::remove(connections.begin(), connections.end(), fd), connections.end());
+        finishedWorkers.push_back(std::this_thread::get_id());
+    }
+    ::close(fd);
+}
+
+void StandinServer::reapWorkers() {
+    for (std::thread::id id : finishedWorkers) {
+        auto worker = std::find_if(workers.begin(), workers.end(), [id](const std::thread& t) { return t.get_id() == id; });
+        if (worker != workers.end()) {
+            // serve() has returned, so this join does not wait on a live connection
+            worker->join();
+            workers.erase(worker);
+        }
+    }
+    finishedWorkers.clear();
+}
+
+void StandinServer::answerRequests(int fd) {
+    std::string buffer;
+    char chunk[4096];
+    while (running) {
+        std::size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            const ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                if (received < 0 && errno == EINTR) continue;
+                headerEnd = std::string::npos;
+                break;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(received));
+        }
+        if (headerEnd == std::string::npos) break;
+
+        // request line: "GET /query?... HTTP/1.1"
+        const std::string_view request(buffer.data(), headerEnd);
+        const std::size_t methodEnd = request.find(' ');
+        const std::size_t targetEnd = request.find(' ', methodEnd + 1);
+        const std::string_view target = request.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+        const std::size_t question = target.find('?');
+        const std::string_view path = target.substr(0, question);
+        const std::string_view query = question == std::string_view::npos ? std::string_view() : target.substr(question + 1);
+        const bool wellFormed = wellFormedQuery(query);
+
+        std::size_t requestNumber;
+        int delayMs = options.latencyMs;
+        bool fail;
+        {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            requestNumber = ++counters.requests;
+            if (options.jitterMs > 0) {
+                delayMs += static_cast<int>(random() % static_cast<std::uint64_t>(options.jitterMs + 1));
+            }
+            fail = options.errorRate > 0 && std::uniform_real_distribution<double>(0, 1)(random) < options.errorRate;
+        }
+        if (wellFormed && !options.slowSymbol.empty() && queryValue(query, "symbol") == options.slowSymbol) {
+            delayMs += options.slowMs;
+        }
+        if (delayMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        }
+
+        std::string response;
+        if (path != "/query") {
+            response = httpResponse(404, "Not Found", R"({"Error Message": "Unknown endpoint."})");
+        } else if (!wellFormed) {
+            response = httpResponse(400, "Bad Request", R"({"Error Message": "Malformed escape in query string."})");
+        } else if (fail) {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            counters.errors++;
+            response = httpResponse(500, "Internal Server Error", R"({"Error Message": "Injected server error."})");
+        } else if (options.rateLimitEvery > 0 && requestNumber % static_cast<std::size_t>(options.rateLimitEvery) == 0) {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            counters.rateLimited++;
+            // Alpha Vantage signals throttling with a 200 and a "Note" body
+            response = httpResponse(200, "OK", R"({"Note": "Thank you for using Alpha Vantage! Our standard API call frequency is 5 calls per minute and 25 calls per day."})");
+        } else {
+            response = httpResponse(200, "OK", render(query));
+        }
+
+        buffer.erase(0, headerEnd + 4);
+        if (!sendAll(fd, response)) break;
+    }
+}
+
+std::string StandinServer::render(std::string_view query) {
+    const std::string function = queryValue(query, "function");
+    const std::string symbol = queryValue(query, "symbol");
+    const std::string interval = queryValue(query, "interval");
+    if (function != "TIME_SERIES_INTRADAY" || symbol.empty() || parseInterval(interval) != barInterval) {
+        return R"({"Error Message": "Invalid API call. Please retry or visit the documentation (https://www.alphavantage.co/documentation/) for TIME_SERIES_INTRADAY."})";
+    }
+    const bool full = queryValue(query, "outputsize") == "full";
+    // bars up to and including the current 5min slot, on US/Eastern standard time (no DST)
+    timestamp from = std::numeric_limits<timestamp>::min();
+    timestamp to = (feedNow() / barInterval + 1) * barInterval;
+    std::size_t count = full ? options.fullBars : options.compactBars;
+    const std::string month = queryValue(query, "month");
+    if (!month.empty()) {
+        timestamp start;
+        try {
+            if (month.size() != 7) throw std::runtime_error("Malformed month");
+            start = parseTimestamp(month + "-01");
+        } catch (const std::runtime_error&) {
+            return R"({"Error Message": "Invalid API call. The month parameter must be YYYY-MM."})";
+        }
+        // 31 days after the 1st always lands in the following month
+        const std::string next = formatTimestamp(start + 31 * 86400).substr(0, 7);
+        from = start;
+        to = std::min(to, parseTimestamp(next + "-01"));
+        if (full) count = std::numeric_limits<std::size_t>::max();
+    }
+    const std::vector<data> bars = to > from ? barsFor(symbol, count, from, to) : std::vector<data>();
+
+    std::string body;
+    body.reserve(200 + bars.size() * 180);
+    body += "{\n    \"Meta Data\": {\n";
+    body += "        \"1. Information\": \"Intraday (5min) open, high, low, close prices and volume\",\n";
+    body += "        \"2. Symbol\": \"" + symbol + "\",\n";
+    body += "        \"3. Last Refreshed\": \"" + (bars.empty() ? std::string() : formatTimestamp(bars.front().time)) + "\",\n";
+    body += "        \"4. Interval\": \"5min\",\n";
+    body += std::string("        \"5. Output Size\": \"") + (full ? "Full size" : "Compact") + "\",\n";
+    body += "        \"6. Time Zone\": \"US/Eastern\"\n    },\n";
+    body += "    \"Time Series (5min)\": {";
+
+    char line[256];
+    for (std::size_t i = 0; i < bars.size(); ++i) {
+        const data& d = bars[i];
+        std::snprintf(line, sizeof(line),
+                      "%s\n        \"%s\": {\n            \"1. open\": \"%.4f\",\n            \"2. high\": \"%.4f\",\n"
+                      "            \"3. low\": \"%.4f\",\n            \"4. close\": \"%.4f\",\n            \"5. volume\": \"%.0f\"\n        }",
+                      i == 0 ? "" : ",", formatTimestamp(d.time).c_str(), d.open, d.high, d.low, d.close, d.volume);
+        body += line;
+    }
+    body += "\n    }\n}";
+    return body;
+}
+
+std::vector<data> StandinServer::barsFor(std::string_view symbol, std::size_t count, timestamp from, timestamp to) const {
+    std::vector<data> bars;
+    if (store) {
+        for (std::size_t i = store->size(); i-- > 0 && bars.size() < count;) {
+            const data bar = store->bar(i);
+            if (bar.time < from) break;
+            if (bar.time < to) bars.push_back(bar);
+        }
+        return bars;
+    }
+
+    // newest bar is the last slot before `to`
+    const std::int64_t newestSlot = (to - 1) / barInterval;
+    const std::uint64_t seed = std::hash<std::string_view>()(symbol) ^ options.seed;
+    const double base = 50 + noise(seed, -1) * 450;
+
+    for (std::int64_t slot = newestSlot; bars.size() < count && slot * barInterval >= from; --slot) {
+        auto price = [&](std::int64_t s) {
+            const double drift = std::sin(static_cast<double>(s) / 97.0) * 0.02 + std::sin(static_cast<double>(s) / 13.0) * 0.005;
+            return std::round(base * (1 + drift) * 10000) / 10000;
+        };
+        const double open = price(slot - 1);
+        const double close = price(slot);
+        const double spread = std::round(base * 0.002 * noise(seed, slot) * 10000) / 10000;
+        const double volume = std::round(1000 + noise(seed ^ 0x5555, slot) * 50000);
+        bars.emplace_back(slot * barInterval, open, close, std::max(open, close) + spread, std::min(open, close) - spread, volume);
+    }
+    return bars;
+}
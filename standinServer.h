@@ -0,0 +1,133 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef STANDINSERVER_H
+#define STANDINSERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "barStore.h"
+#include "data.h"
+
+/**
+ * @brief Knobs of a StandinServer.
+ */
+struct standinOptions {
+    unsigned short port = 0;       // 0 picks a free port
+    int latencyMs = 0;             // fixed delay before every response
+    int jitterMs = 0;              // extra uniformly random delay, 0 through jitterMs
+    double errorRate = 0;          // fraction of requests answered with HTTP 500
+    int rateLimitEvery = 0;        // every Nth request gets the "Note" rate limit body; 0 disables
+    std::size_t compactBars = 100; // bars in an outputsize=compact response
+    std::size_t fullBars = 5000;   // bars in an outputsize=full response without a month
+    std::string barStorePath;      // serve the newest bars of this .bars file instead of synthetic data
+    std::uint64_t seed = 1;        // seed of the latency, error and synthetic price generators
+    std::string slowSymbol;        // requests for this symbol wait a further slowMs, to reorder completions
+    int slowMs = 0;
+};
+
+/**
+ * @brief Counters of the requests a StandinServer has answered.
+ */
+struct standinStats {
+    std::size_t connections = 0; // accepted, so a client reusing keep-alive connections keeps this low
+    std::size_t requests = 0;
+    std::size_t errors = 0;
+    std::size_t rateLimited = 0;
+};
+
+/**
+ * @class StandinServer
+ * @brief Loopback HTTP server that emulates Alpha Vantage's TIME_SERIES_INTRADAY endpoint.
+ *
+ * Serves "GET /query?function=TIME_SERIES_INTRADAY&symbol=...&interval=5min" with a response
+ * shaped like the real one, built from a .bars file or from a deterministic synthetic price
+ * path whose newest bar is the current 5min slot, so repeated polls see new bars appear.
+ * A "month=YYYY-MM" parameter restricts the bars to that calendar month, as a backfill
+ * slice; with outputsize=full the whole month (up to the current slot) is returned.
+ * Latency, jitter, server errors and rate limit responses can be injected to exercise the
+ * fetch layer offline. Connections are kept alive and each is served on its own thread;
+ * threads of closed connections are joined as new connections arrive.
+ */
+class StandinServer {
+public:
+    explicit StandinServer(standinOptions options = standinOptions());
+
+    /**
+     * Stops the server if it is still running.
+     */
+    ~StandinServer();
+
+    StandinServer(const StandinServer&) = delete;
+    StandinServer& operator=(const StandinServer&) = delete;
+
+    /**
+     * Binds 127.0.0.1 and starts accepting connections on a background thread.
+     *
+     * @throws std::runtime_error if the socket cannot be bound or the bar store cannot be opened.
+     */
+    void start();
+
+    /**
+     * Closes the listening socket and every open connection, then joins all threads.
+     */
+    void stop();
+
+    /**
+     * @return The bound port; valid after start().
+     */
+    unsigned short port() const { return boundPort; }
+
+    /**
+     * @return The query endpoint to hand to the fetch layer, e.g. "http://127.0.0.1:8080/query".
+     */
+    std::string url() const;
+
+    /**
+     * @return A snapshot of the request counters.
+     */
+    standinStats stats() const;
+
+    /**
+     * Renders the body Alpha Vantage would return for a query string, without any injected faults.
+     *
+     * @param query The part of the request target after '?'.
+     * @return The JSON body.
+     * @throws std::invalid_argument if a parameter holds a malformed "%XX" escape.
+     */
+    std::string render(std::string_view query);
+
+private:
+    standinOptions options;
+    std::unique_ptr<BarStore> store;
+    int listenFd = -1;
+    unsigned short boundPort = 0;
+    std::atomic<bool> running{false};
+    std::thread acceptor;
+
+    std::mutex connectionMutex;
+    std::vector<std::thread> workers;
+    std::vector<std::thread::id> finishedWorkers; // returned from serve(), joined on the next accept
+    std::vector<int> connections;
+
+    mutable std::mutex statsMutex;
+    standinStats counters;
+    std::mt19937_64 random;
+
+    void acceptLoop();
+    void serve(int fd);
+    void answerRequests(int fd);
+    void reapWorkers();
+    std::vector<data> barsFor(std::string_view symbol, std::size_t count, timestamp from, timestamp to) const;
+};
+
+#endif //STANDINSERVER_H
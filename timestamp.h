@@ -0,0 +1,132 @@
+//
+// Created by Joshua Yoon on 10/17/26.
+//
+
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Seconds since 1970-01-01 00:00:00 on the feed's wall clock.
+ *
+ * Alpha Vantage keys every bar by a "YYYY-MM-DD HH:MM:SS" string in the zone named by
+ * "6. Time Zone" (US/Eastern). The value is kept on that wall clock rather than shifted
+ * to UTC, so formatting it back reproduces the feed's key exactly.
+ */
+using timestamp = std::int64_t;
+
+/**
+ * Converts a proleptic Gregorian calendar date to a day count relative to 1970-01-01.
+ *
+ * @param y The year.
+ * @param m The month, 1 through 12.
+ * @param d The day of the month, 1 through 31.
+ * @return The number of days since 1970-01-01 (negative for earlier dates).
+ */
+inline std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+/**
+ * Parses a feed key of the form "YYYY-MM-DD HH:MM:SS" (or a bare "YYYY-MM-DD").
+ *
+ * The layout is fixed, so every digit is read at a known offset and all validity checks are
+ * OR-ed into a single flag; the only branch taken per key is the final error check.
+ *
+ * @param text The key as it appears in the JSON document.
+ * @return The timestamp the key denotes.
+ * @throws std::runtime_error if the text is not a well-formed key or names a day the month
+ *         does not have (leap years included).
+ */
+inline timestamp parseTimestamp(std::string_view text) {
+    const bool hasTime = text.size() == 19;
+    if (text.size() != 10 && !hasTime) {
+        throw std::runtime_error("Malformed timestamp");
+    }
+    // a bare date is read as midnight
+    char key[19] = {'0', '0', '0', '0', '-', '0', '0', '-', '0', '0', ' ', '0', '0', ':', '0', '0', ':', '0', '0'};
+    std::memcpy(key, text.data(), text.size());
+
+    unsigned bad = 0;
+    auto digit = [&](int i) {
+        const unsigned d = static_cast<unsigned char>(key[i]) - static_cast<unsigned>('0');
+        bad |= d > 9;
+        return d;
+    };
+    const unsigned year = digit(0) * 1000 + digit(1) * 100 + digit(2) * 10 + digit(3);
+    const unsigned month = digit(5) * 10 + digit(6);
+    const unsigned day = digit(8) * 10 + digit(9);
+    const unsigned hour = digit(11) * 10 + digit(12);
+    const unsigned minute = digit(14) * 10 + digit(15);
+    const unsigned second = digit(17) * 10 + digit(18);
+
+    bad |= (key[4] ^ '-') | (key[7] ^ '-') | (key[10] ^ ' ') | (key[13] ^ ':') | (key[16] ^ ':');
+    // the month length is looked up rather than branched on; out of range months read 0
+    static constexpr unsigned char monthDays[16] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0};
+    const unsigned leap = (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0));
+    const unsigned daysInMonth = monthDays[month & 15] + ((month == 2) & leap);
+    bad |= (month - 1 > 11) | (day - 1 >= daysInMonth) | (hour > 23) | (minute > 59) | (second > 60);
+    if (bad) {
+        throw std::runtime_error("Malformed timestamp");
+    }
+    return daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+/**
+ * Formats a timestamp back into the feed's "YYYY-MM-DD HH:MM:SS" key form.
+ *
+ * @param t The timestamp to format.
+ * @return The formatted key.
+ */
+inline std::string formatTimestamp(timestamp t) {
+    std::int64_t days = t / 86400;
+    std::int64_t secs = t % 86400;
+    if (secs < 0) {
+        secs += 86400;
+        days -= 1;
+    }
+
+    // Inverse of daysFromCivil.
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    const std::int64_t y = static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2);
+
+    char buffer[48];
+    std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u %02d:%02d:%02d",
+                  static_cast<long long>(y), m, d,
+                  static_cast<int>(secs / 3600), static_cast<int>(secs / 60 % 60), static_cast<int>(secs % 60));
+    return buffer;
+}
+
+/**
+ * Returns the current time on the feed's clock.
+ *
+ * US/Eastern is approximated by standard time (UTC-5) all year, so during daylight saving
+ * time the result runs an hour behind the feed: a day is only ever judged closed late.
+ *
+ * @return The current timestamp.
+ */
+inline timestamp feedNow() {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::seconds>(now).count() - 5 * 3600;
+}
+
+#endif //TIMESTAMP_H